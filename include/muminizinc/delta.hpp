@@ -0,0 +1,217 @@
+#ifndef DELTA_HPP
+#define DELTA_HPP
+
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint8_t
+#include <memory>        // std::unique_ptr
+#include <optional>      // std::optional
+#include <span>          // std::span
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+/**
+ * @file
+ * @brief Reuse of the FlatZinc of the original model for the mutants that only change a constraint item.
+ */
+namespace MuMiniZinc
+{
+
+/** A span of a model file, from its first line and column to its last ones, all starting at one. */
+struct Span
+{
+    std::size_t first_line {};
+    std::size_t first_column {};
+    std::size_t last_line {};
+    std::size_t last_column {};
+};
+
+/** A top-level item of a FlatZinc model. */
+struct FlatItem
+{
+    /** The kinds of FlatZinc items. */
+    enum class Kind : std::uint8_t
+    {
+        /** A parameter or variable declaration. */
+        Declaration,
+        /** A `constraint` item. */
+        Constraint,
+        /** The `solve` item. */
+        Solve,
+        /** Any other item, like predicate declarations. */
+        Other
+    };
+
+    /** The kind of the item. */
+    Kind kind {};
+
+    /** The item, without the trailing semicolon. */
+    std::string_view text;
+
+    /** For declarations, the declared identifier. */
+    std::string_view name;
+
+    /** For declarations, whether the identifier has been introduced by the compiler. */
+    bool is_introduced {};
+
+    /** For declarations, whether a variable or an array of variables is declared. */
+    bool is_variable {};
+
+    /** For constraints, the model file of the outermost element of its `mzn_path` annotation. */
+    std::string_view path_file;
+
+    /** For constraints, the span of the outermost element of its `mzn_path` annotation, whose first line is zero if there is none. */
+    Span path_span;
+
+    /** For constraints, the variable given to its `defines_var` annotation, if any. */
+    std::string_view defined_variable;
+};
+
+/** A FlatZinc model, compiled with `--keep-paths`, split into its items. */
+class FlatModel
+{
+public:
+    /**
+     * Parses a FlatZinc model.
+     *
+     * @param contents the contents of the FlatZinc file.
+     */
+    explicit FlatModel(std::string contents);
+
+    /** The items of the model, in the same order as in the file. */
+    [[nodiscard]] std::span<const FlatItem> items() const noexcept { return m_items; }
+
+    /**
+     * Finds the declaration of an identifier.
+     *
+     * @param name the identifier.
+     *
+     * @return a pointer to the declaration, or `nullptr` if there is none.
+     */
+    [[nodiscard]] const FlatItem* find_declaration(std::string_view name) const noexcept;
+
+private:
+    std::unique_ptr<const std::string> m_contents;
+    std::vector<FlatItem> m_items;
+    std::unordered_map<std::string_view, std::size_t> m_declarations;
+};
+
+/** A constraint item of a MiniZinc model, along with the FlatZinc that the model has been compiled to. */
+struct FlattenedItem
+{
+    /** The FlatZinc of the model. */
+    const FlatModel& flat_model;
+
+    /** The path of the model, exactly as it has been given to the compiler. */
+    std::string_view file;
+
+    /** The contents of the model. */
+    std::string_view model;
+
+    /** The constraint item. It must be a view to MuMiniZinc::FlattenedItem::model. */
+    std::string_view item;
+};
+
+/**
+ * Finds the decision variables declared by the top-level items of a MiniZinc model.
+ *
+ * @param items the items of the model, as returned by MuMiniZinc::detail::split_items.
+ *
+ * @return the names of the variables and arrays of variables.
+ */
+[[nodiscard]] std::vector<std::string_view> find_variable_declarations(std::span<const std::string_view> items);
+
+/**
+ * Replaces the FlatZinc contributed by a constraint item of the original model with the FlatZinc
+ * contributed by its mutated version, without flattening the rest of the mutant again.
+ *
+ * The mutated item must have been flattened along with the declarations of the original model
+ * (all its items but the constraints), whose FlatZinc must be given as \p declarations too. The
+ * FlatZinc models must have been compiled with `--keep-paths` and with the same data.
+ *
+ * The constraints contributed by an item are those whose `mzn_path` starts within its span in
+ * its model file. The replacement is not done, and a full flattening of the mutant is required,
+ * if any of the items have changed the domain of a variable they mention, if the original item
+ * defines a variable used by other items, if no constraint can be attributed to the original item,
+ * if the FlatZinc of the declarations differs between \p declarations and \p mutated, like when the
+ * mutated item shares a common subexpression with them, or if a variable cannot be matched between
+ * the models.
+ *
+ * @param original the original item and the FlatZinc of the original model.
+ * @param mutated the mutated item and the FlatZinc of the declarations of the original model and the mutated item.
+ * @param declarations the FlatZinc of the declarations of the original model.
+ * @param variables the decision variables of the original model, from MuMiniZinc::find_variable_declarations.
+ *
+ * @return the FlatZinc of the mutant, or `std::nullopt` if the replacement cannot be done.
+ */
+[[nodiscard]] std::optional<std::string> replace_flattened_item(const FlattenedItem& original, const FlattenedItem& mutated, const FlatModel& declarations, std::span<const std::string_view> variables);
+
+} // namespace MuMiniZinc
+
+namespace MuMiniZinc::detail
+{
+
+/** The top-level item of a model that has been changed to obtain a mutant. */
+struct MutatedItem
+{
+    /** The kinds of top-level items. */
+    enum class Kind : std::uint8_t
+    {
+        /** A `constraint` item. */
+        Constraint,
+        /** The `solve` item. */
+        Solve,
+        /** An `output` item. */
+        Output,
+        /** Any other item, like declarations, assignments or functions. */
+        Other
+    };
+
+    /** The kind of the item. */
+    Kind kind;
+
+    /** The position of the item among the items of the model. */
+    std::size_t index;
+
+    /** The item in the original model, without the trailing semicolon. */
+    std::string_view original;
+
+    /** The item in the mutant, without the trailing semicolon. */
+    std::string_view mutated;
+};
+
+/**
+ * Splits a MiniZinc or FlatZinc model into its top-level items. Comments are not removed.
+ *
+ * @param model the contents of the model.
+ *
+ * @return views to \p model of every item, without the trailing semicolon and the surrounding whitespace.
+ */
+[[nodiscard]] std::vector<std::string_view> split_items(std::string_view model);
+
+/**
+ * Determines the kind of a top-level item.
+ *
+ * @param item an item, as returned by MuMiniZinc::detail::split_items.
+ *
+ * @return the kind of the item.
+ */
+[[nodiscard]] MutatedItem::Kind get_item_kind(std::string_view item) noexcept;
+
+/**
+ * Finds the item of the normalized model that has been changed to obtain a mutant, from the position
+ * the mutation has been made at.
+ *
+ * @param normalized_model the normalized original model.
+ * @param mutant the contents of the mutant.
+ * @param index the position of the mutated item, from MuMiniZinc::Entry::mutated_item.
+ *
+ * @return the mutated item, whose views point to \p normalized_model and \p mutant, or `std::nullopt`
+ *         if the models do not have the same amount of items or do not differ at \p index.
+ */
+[[nodiscard]] std::optional<MutatedItem> find_mutated_item(std::string_view normalized_model, std::string_view mutant, std::size_t index);
+
+} // namespace MuMiniZinc::detail
+
+#endif
@@ -2,8 +2,10 @@
 #define EXECUTOR_HPP
 
 #include <chrono>      // std::chrono::seconds
+#include <cstdint>     // std::uint64_t
 #include <exception>   // std::runtime_error
 #include <filesystem>  // std::filesystem::path
+#include <iosfwd>      // std::istream, std::ostream
 #include <span>        // std::span
 #include <string>      // std::string
 #include <string_view> // std::string_view
@@ -40,6 +42,12 @@ struct execution_args
     /** The entries that will be filled with the results of the execution. */
     std::span<Entry> entries;
 
+    /**
+     * If not empty, it is filled with the resources used by the original model with every data file, or
+     * with the model alone if there are no data files. It must have one element for each of them.
+     */
+    std::span<Entry::Usage> original_usages;
+
     /**
      * The normalized model, which will be executed.
      * Its output will be compared against the mutants' output.
@@ -55,10 +63,15 @@ struct execution_args
     std::chrono::seconds timeout;
 
     /**
-     * The maximum number of concurrent compiler executions. If zero, the execution will be
-     * single-threaded.
+     * The maximum number of concurrent compiler executions. If zero, it will be the number of
+     * hardware threads divided by the number of threads requested to the solver through
+     * `-p` or `--parallel` in the compiler arguments.
      *
-     * The retrival of the output and mutant comparison is always single-threaded.
+     * If the system runs out of file descriptors or processes, fewer executions will be
+     * launched until some of the running ones finish.
+     *
+     * The retrieval of the output and mutant comparison is done on
+     * MuMiniZinc::execution_args::io_threads threads.
      */
     std::uint64_t n_jobs;
 
@@ -70,7 +83,7 @@ struct execution_args
 
     /**
      * Checks that the compiler version matches the version of MiniZinc
-     * used for compiling this project.
+     * used for compiling this project. Ignored by MuMiniZinc::ExecutionEngine::InProcess.
      *
      * Causes \ref BadVersion to be thrown if not found.
      */
@@ -78,6 +91,222 @@ struct execution_args
 
     /** Where to output the progress. */
     logging::output output_log;
+
+    /** How the models will be executed. */
+    ExecutionEngine engine;
+
+    /**
+     * Evaluates the mutants that only change an output item, according to MuMiniZinc::Entry::mutated_item, by running
+     * the output stage of the compiler (`--ozn-file`) on the solutions of the original model, instead of solving them again.
+     * The original model is then compiled and solved in separate stages.
+     *
+     * Ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    bool reuse_original_solutions;
+
+    /**
+     * The maximum amount of bytes of standard output kept from an execution whose output is captured, like
+     * the original model. An execution that writes more is stopped and its job is marked as
+     * MuMiniZinc::Entry::Status::LimitExceeded. The output of the mutants is compared while it is read,
+     * so it is not affected. If zero, there is no limit.
+     *
+     * Ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::uint64_t max_output_size;
+
+    /**
+     * The maximum amount of bytes of error output kept from an execution. The rest is read and
+     * discarded. If zero, there is no limit.
+     *
+     * Ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::uint64_t max_error_size;
+
+    /**
+     * Writes the model and every mutant once to a scratch directory in memory (`/dev/shm`, if available),
+     * and gives their paths to the compiler instead of piping them with every data file. Every execution
+     * gets a temporary directory of its own there through `TMPDIR`, which is removed when it finishes.
+     *
+     * With MuMiniZinc::ExecutionEngine::Delta or MuMiniZinc::execution_args::reuse_original_solutions, it
+     * only moves the files of the stages to memory. Ignored by MuMiniZinc::ExecutionEngine::InProcess and with
+     * MuMiniZinc::execution_args::worker_command.
+     */
+    bool shared_files;
+
+    /** The order in which the executions of the mutants are launched. */
+    SchedulingPolicy scheduling;
+
+    /**
+     * Once there are fewer mutant executions left than free jobs, gives the remaining ones more
+     * solver threads through `-p`, up to the amount of idle jobs, replacing any `-p` or `--parallel`
+     * of the compiler arguments. The output of the mutants must not depend on the amount of
+     * threads, so only enable it for deterministic solvers.
+     *
+     * Only used by MuMiniZinc::ExecutionEngine::Process.
+     */
+    bool boost_tail_threads;
+
+    /**
+     * Spawns the executions through `vfork`, which does not copy the page tables of this process,
+     * so launching a process does not get slower as more mutants are held in memory.
+     *
+     * Only used on Unix systems, and ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    bool use_vfork;
+
+    /**
+     * The amount of threads that launch the executions, read their output and compare it, which is
+     * one by default, like the `--io-threads` option. If zero, it will be the number of hardware
+     * threads. Ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::uint64_t io_threads { 1 };
+
+    /**
+     * Passes `--statistics` to the compiler. The `%%%mzn-stat` lines are removed from the output
+     * before it is compared, so they do not make the mutants dead, and they are stored in
+     * MuMiniZinc::Entry::Usage::statistics.
+     */
+    bool statistics;
+
+    /**
+     * The path of a file where the results are cached between runs. An execution whose mutant, original model,
+     * data file, compiler arguments, compiler version, engine, launcher and limits are the same as in a previous
+     * run is not run again, and its status and resources are taken from the cache. The cache is updated once every execution has
+     * finished. If empty, there is no cache.
+     *
+     * The staged engines only skip the mutants that are cached with every data file.
+     */
+    std::filesystem::path cache_path;
+
+    /**
+     * A directory with the expected outputs of the original model, used instead of running it. There must be
+     * a file for every data file, named after its normalized path with `/` written as `%2F`, `:` as `%3A` and
+     * `%` as `%25`, followed by `.out` (`original.out` without data files), like the ones written through
+     * MuMiniZinc::execution_args::write_golden_outputs_path. If empty, the original model is run.
+     *
+     * The resources used by the original model are then unknown, so MuMiniZinc::execution_args::original_usages
+     * is left with zeros and MuMiniZinc::SchedulingPolicy::LongestFirst keeps the mutants in order. The golden
+     * outputs are part of the keys of the cache and the journal.
+     *
+     * Not used by MuMiniZinc::ExecutionEngine::Delta nor with MuMiniZinc::execution_args::reuse_original_solutions,
+     * which need the FlatZinc or the solutions of the original model.
+     */
+    std::filesystem::path golden_outputs_path;
+
+    /** A directory where the outputs of the original model are written once the run finishes. If empty, they are not written. */
+    std::filesystem::path write_golden_outputs_path;
+
+    /**
+     * A file where every execution of a mutant is recorded as soon as it finishes, with the same keys as
+     * MuMiniZinc::execution_args::cache_path, so an interrupted run can be resumed. If empty, there is no journal.
+     */
+    std::filesystem::path journal_path;
+
+    /**
+     * Whether to take the results recorded in MuMiniZinc::execution_args::journal_path by a previous run
+     * instead of running them again. The journal is appended to instead of being started again.
+     */
+    bool resume;
+
+    /**
+     * Whether SIGINT and SIGTERM stop the solvers instead of the process. The executions that have not
+     * finished are marked as MuMiniZinc::Entry::Status::Interrupted, and the results are returned as usual.
+     * The signals are only caught while there are executions to run.
+     */
+    bool handle_interrupts;
+
+    /** The shard of the mutants to run, from zero to MuMiniZinc::execution_args::shard_count minus one. */
+    std::uint64_t shard_index;
+
+    /**
+     * The amount of shards the mutants are split into, so a run can be spread across several processes or
+     * machines. A mutant belongs to the shard given by a hash of its name, so the shards do not depend on
+     * the order the mutants are found in. Only the mutants of MuMiniZinc::execution_args::shard_index are
+     * run, and the rest are left without results. If zero or one, all mutants are run.
+     */
+    std::uint64_t shard_count;
+
+    /**
+     * A shell command that starts a worker (`muminizinc worker`, which runs MuMiniZinc::run_worker), like
+     * `ssh node{worker} muminizinc worker`, with `{worker}` replaced by the index of the worker. If not empty,
+     * MuMiniZinc::execution_args::n_jobs workers are started and every execution is sent to the first worker
+     * that is free, so the work stays balanced however long the executions take. The workers can then run
+     * locally, on other machines or under a batch scheduler, but they must be able to read the data files
+     * through the same paths. If a worker exits or fails, the execution it was running is sent to another
+     * one, and the run only fails once no worker is left.
+     *
+     * Not used by MuMiniZinc::ExecutionEngine::InProcess, MuMiniZinc::ExecutionEngine::Delta nor with
+     * MuMiniZinc::execution_args::reuse_original_solutions. The workers cannot be interrupted, and
+     * MuMiniZinc::execution_args::shared_files and MuMiniZinc::execution_args::pin_cpus do not apply to them.
+     */
+    std::string_view worker_command;
+
+    /**
+     * A command every execution is wrapped in, like `taskset -c {cpu}`, `nice` or a cluster job launcher, to
+     * control where the executions run and what they can use. It is given as its arguments, the first one
+     * being the path of its executable, and the compiler and its arguments are appended to them. In them,
+     * `{slot}` is replaced by the job slot of the execution (from zero to MuMiniZinc::execution_args::n_jobs
+     * minus one), `{cpu}` by the list of the CPUs that belong to its slots, as many per slot as threads are
+     * given to the solver, and `{job}` by the number of the execution. If empty, the compiler is run directly.
+     *
+     * The launcher must run the compiler in its own process or replace itself with it, so stopping the
+     * launcher stops the compiler. The CPUs of MuMiniZinc::execution_args::pin_cpus and the resource limits
+     * are set on the launcher, so they apply to it as well as to the compiler, which inherits them. A launcher
+     * that changes them, like `taskset -c`, overrides them for the compiler. Ignored by
+     * MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::span<const std::string> launcher;
+
+    /**
+     * Whether every execution is pinned to CPUs of its own, so the solvers do not migrate between cores
+     * and keep their caches. Every job slot gets as many CPUs as threads are given to the solver, taken
+     * from the same NUMA node when the topology is known, and the first thread of every core before its
+     * siblings. When an execution finishes, its CPUs go to the next one that takes its slots. The CPUs are
+     * the same as the `{cpu}` of MuMiniZinc::execution_args::launcher.
+     *
+     * Only on Linux. Ignored by MuMiniZinc::ExecutionEngine::InProcess and with
+     * MuMiniZinc::execution_args::worker_command.
+     */
+    bool pin_cpus;
+
+    /**
+     * The maximum bytes of address space of every process of an execution (`RLIMIT_AS`), so a mutant whose
+     * flattening or search explodes fails on its own instead of making the system run out of memory. An
+     * execution that fails to allocate memory is marked as MuMiniZinc::Entry::Status::LimitExceeded. If
+     * the original model exceeds it, MuMiniZinc::ExecutionError is thrown. If zero, there is no limit.
+     *
+     * Only on POSIX systems. Ignored by MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::uint64_t memory_limit;
+
+    /**
+     * The maximum CPU time of every process of an execution (`RLIMIT_CPU`). Unlike the time limit given to
+     * the solver, it counts the flattening too, and the process is killed when it reaches it. An execution
+     * that is killed is marked as MuMiniZinc::Entry::Status::LimitExceeded. If zero, there is no limit.
+     *
+     * Only on POSIX systems, and the executions are only recognized as killed on Linux. Ignored by
+     * MuMiniZinc::ExecutionEngine::InProcess.
+     */
+    std::chrono::seconds cpu_time_limit;
+};
+
+/** Arguments for the MuMiniZinc::run_worker function. */
+struct worker_args
+{
+    /** The path of the compiler. */
+    std::reference_wrapper<const std::filesystem::path> compiler_path;
+
+    /** Where the jobs are read from. */
+    std::istream& input;
+
+    /** Where the results are written. */
+    std::ostream& output;
+
+    /** Spawns the executions through `vfork`, like MuMiniZinc::execution_args::use_vfork. */
+    bool use_vfork;
+
+    /** A command every execution is wrapped in, like MuMiniZinc::execution_args::launcher. */
+    std::span<const std::string> launcher;
 };
 
 /**
@@ -115,6 +344,27 @@ class ExecutionError : public std::runtime_error
  */
 void execute_mutants(const execution_args& parameters);
 
+/**
+ * Runs the jobs sent by MuMiniZinc::execute_mutants through MuMiniZinc::execution_args::worker_command,
+ * one at a time, until the input ends.
+ *
+ * Every job is a line with a JSON object: its `id`, the `model`, its `arguments` for the compiler, the
+ * `data_file` if any, the `timeout` in seconds, the `max_output_size` and `max_error_size`, the
+ * `memory_limit` in bytes and the `cpu_time_limit` in seconds, whether to remove the `statistics` and,
+ * for the mutants, the number of the expected output as `expected_id`. The `expected` output itself is
+ * only sent with the first job of the worker that needs it, and is kept for the next ones.
+ *
+ * For every job, a line is written back with a JSON object with the `id`, whether the execution has been
+ * a `success`, the `output` or the error output, whether it `matches` the expected output (`null` if it
+ * has been captured instead), whether it has `timed_out` or `limit_exceeded`, the `exit_code` of the
+ * compiler if it has exited by itself (`null` otherwise) and its `usage`.
+ *
+ * @param parameters the parameters.
+ *
+ * @throws ExecutionError if a job cannot be parsed, or it refers to an expected output that has not been sent.
+ */
+void run_worker(const worker_args& parameters);
+
 } // namespace MuMiniZinc
 
 #endif
\ No newline at end of file
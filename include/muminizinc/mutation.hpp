@@ -2,12 +2,16 @@
 #define MUTATION_HPP
 
 #include <array>       // std::array
+#include <chrono>      // std::chrono::microseconds, std::chrono::seconds
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint8_t, std::uint64_t
 #include <filesystem>  // std::filesystem::path
 #include <functional>  // std::reference_wrapper
+#include <optional>    // std::optional
 #include <span>        // std::span
 #include <string>      // std::string
 #include <string_view> // std::string_view
-#include <utility>     // std::move, std::reference_wrapper
+#include <utility>     // std::move, std::pair, std::reference_wrapper
 #include <variant>     // std::variant
 #include <vector>      // std::vector
 
@@ -90,27 +94,77 @@ struct Entry
         Alive,
         /**
          * The result of the execution of the mutant is different to the original.
-         * The origin of this difference may be because it timed out.
+         * A mutant that reaches the time limit is MuMiniZinc::Entry::Status::Timeout instead.
          */
         Dead,
         /** An error had occurred when executing this mutant. */
-        Invalid
+        Invalid,
+        /** The output is different because the time limit has been reached, either by the solver or by the hard limit of the executor. */
+        Timeout,
+        /** The run has been interrupted before this execution finished. */
+        Interrupted,
+        /** The execution has been stopped for exceeding its memory, CPU time or output size limit. */
+        LimitExceeded
+    };
+
+    /** The resources used by the execution of the mutant with a data file, and the statistics reported by the solver. */
+    struct Usage
+    {
+        /** Default three-way comparison. */
+        [[nodiscard]] constexpr auto operator<=>(const Usage&) const noexcept = default;
+
+        /** The time between the launch of the process and its exit. */
+        std::chrono::microseconds wall_time {};
+
+        /**
+         * The CPU time spent in user mode by the process and the children it has waited for. `std::nullopt` if it
+         * has not been measured, which needs the process to be reaped with `wait4`, only done on Linux and by
+         * MuMiniZinc::ExecutionEngine::InProcess.
+         */
+        std::optional<std::chrono::microseconds> user_time {};
+
+        /** The CPU time spent in kernel mode by the process and the children it has waited for, if it has been measured. */
+        std::optional<std::chrono::microseconds> system_time {};
+
+        /** The peak resident set size, in bytes, of the process or its largest waited child, if it has been measured. */
+        std::optional<std::uint64_t> max_rss {};
+
+        /**
+         * The statistics printed by the compiler and the solver as `%%%mzn-stat` lines, like the nodes or the
+         * solve time, with their names and values in the order they were first printed. A statistic printed
+         * several times keeps its last value. Only filled with MuMiniZinc::run_mutants_args::statistics.
+         */
+        std::vector<std::pair<std::string, std::string>> statistics;
     };
 
     /** The results of the mutant tested against every data file. */
     std::vector<Status> results;
 
+    /**
+     * The resources used by the mutant with every data file, in the same order as MuMiniZinc::Entry::results.
+     * This is filled by MuMiniZinc::execute_mutants.
+     */
+    std::vector<Usage> usages;
+
     /** The name of the mutant. */
     std::string name;
 
     /** The contents of the mutant. */
     std::string contents;
+
+    /**
+     * The position of the item of the normalized model that has been mutated, among its top-level items. It is
+     * known for the mutants found by MuMiniZinc::find_mutants, and for the ones MuMiniZinc::dump_mutants has
+     * written with it. The staged engines run the rest as usual.
+     */
+    std::optional<std::size_t> mutated_item;
 };
 
 /** Represents the results of an analysis of a model and the execution of it and its mutants. */
 class EntryResult
 {
     std::vector<Entry> m_mutants;
+    std::vector<Entry::Usage> m_original_usages;
     std::array<std::pair<std::uint64_t, std::uint64_t>, available_operators.size()> m_statistics {};
 
     std::string m_model_name;
@@ -121,7 +175,7 @@ class EntryResult
     friend void run_mutants(const run_mutants_args& parameters);
     friend class Mutator;
 
-    void save_model(const MiniZinc::Model* model, std::string_view operator_name, std::uint64_t location_id, std::uint64_t occurrence_id, std::span<const std::pair<std::string, std::string>> detected_enums);
+    void save_model(const MiniZinc::Model* model, std::size_t item_index, std::string_view operator_name, std::uint64_t location_id, std::uint64_t occurrence_id, std::span<const std::pair<std::string, std::string>> detected_enums);
 
 public:
     /** Default three-way comparison. */
@@ -136,6 +190,12 @@ public:
     /** The normalized original model. */
     [[nodiscard]] constexpr std::string_view normalized_model() const noexcept { return m_model_contents; }
 
+    /**
+     * The resources used by the original model with every data file, in the same order as
+     * MuMiniZinc::Entry::usages. It is empty until the mutants have been run.
+     */
+    [[nodiscard]] constexpr std::span<const Entry::Usage> original_usages() const noexcept { return m_original_usages; }
+
     /**
      * The statistics corresponding to the present operators. Each element of the returned span corresponds to
      * an operator, in the same order as in MuMiniZinc::available_operators. The returned span has the same size as
@@ -210,6 +270,54 @@ struct retrieve_mutants_args
     bool check_model_last_modified_time;
 };
 
+/** The ways in which the models can be executed. */
+enum class ExecutionEngine : std::uint8_t
+{
+    /**
+     * Every execution spawns the compiler, which parses, flattens and solves the model
+     * by itself.
+     */
+    Process,
+    /**
+     * The models are flattened through libminizinc by helpers forked from this process, which
+     * already have the compiler loaded, instead of spawning it. Every helper flattens a single
+     * model, as libminizinc keeps global state, and spawns the FlatZinc solver, whose output it
+     * post-processes. Up to MuMiniZinc::execution_args::n_jobs helpers run at the same time, and
+     * they are killed along with their solvers past the time limit. Only on POSIX systems.
+     *
+     * MuMiniZinc::execution_args::compiler_path is not used, and the standard library and the
+     * solvers are located as the `minizinc` executable would do. If they cannot be found, pass
+     * `--stdlib-dir` through MuMiniZinc::execution_args::compiler_arguments.
+     */
+    InProcess,
+    /**
+     * Like MuMiniZinc::ExecutionEngine::Process, but the original model is only flattened once
+     * per data file. A mutant that only changes a constraint item is run from that FlatZinc,
+     * replacing the constraints contributed by the item with the ones of the mutated item, which
+     * is flattened along with the declarations of the model.
+     *
+     * The rest of the mutants, like the ones that change declarations, the solve item or the
+     * output, the ones whose item changes the domain of a variable or shares a common subexpression
+     * with the declarations, and the ones without MuMiniZinc::Entry::mutated_item, are flattened as usual.
+     */
+    Delta
+};
+
+/** The orders in which the executions of the mutants are launched. */
+enum class SchedulingPolicy : std::uint8_t
+{
+    /** Every mutant is run with every data file, in the same order as the mutants. */
+    Fifo,
+    /**
+     * The executions are launched by the time the original model took with their data file, longest
+     * first, so the slowest ones do not start last and leave the rest of the jobs idle at the end.
+     *
+     * Without data files, or with MuMiniZinc::ExecutionEngine::Delta or reusing the original's
+     * solutions, it behaves like MuMiniZinc::SchedulingPolicy::Fifo.
+     */
+    LongestFirst
+};
+
 /** Arguments for the MuMiniZinc::run_mutants function. */
 struct run_mutants_args
 {
@@ -241,10 +349,15 @@ struct run_mutants_args
     std::chrono::seconds timeout;
 
     /**
-     * The maximum number of concurrent compiler executions. If zero, the execution will be
-     * single-threaded.
+     * The maximum number of concurrent compiler executions. If zero, it will be the number of
+     * hardware threads divided by the number of threads requested to the solver through
+     * `-p` or `--parallel` in the compiler arguments.
+     *
+     * If the system runs out of file descriptors or processes, fewer executions will be
+     * launched until some of the running ones finish.
      *
-     * The retrival of the output and mutant comparison is always single-threaded.
+     * The retrieval of the output and mutant comparison is done on
+     * MuMiniZinc::run_mutants_args::io_threads threads.
      */
     std::uint64_t n_jobs;
 
@@ -258,6 +371,75 @@ struct run_mutants_args
 
     /** Where to output the progress. */
     logging::output output_log;
+
+    /** How the models will be executed, like MuMiniZinc::execution_args::engine. */
+    ExecutionEngine engine;
+
+    /** Whether to evaluate the output-only mutants on the original's solutions, like MuMiniZinc::execution_args::reuse_original_solutions. */
+    bool reuse_original_solutions;
+
+    /** The maximum bytes of standard output kept from an execution, like MuMiniZinc::execution_args::max_output_size. */
+    std::uint64_t max_output_size;
+
+    /** The maximum bytes of error output kept from an execution, like MuMiniZinc::execution_args::max_error_size. */
+    std::uint64_t max_error_size;
+
+    /** Writes the models once to a scratch directory in memory, like MuMiniZinc::execution_args::shared_files. */
+    bool shared_files;
+
+    /** The order in which the executions of the mutants are launched, like MuMiniZinc::execution_args::scheduling. */
+    SchedulingPolicy scheduling;
+
+    /** Gives the idle jobs to the last mutants as solver threads, like MuMiniZinc::execution_args::boost_tail_threads. */
+    bool boost_tail_threads;
+
+    /** Spawns the executions through `vfork`, like MuMiniZinc::execution_args::use_vfork. */
+    bool use_vfork;
+
+    /** The amount of threads that handle the executions, like MuMiniZinc::execution_args::io_threads. */
+    std::uint64_t io_threads { 1 };
+
+    /** Passes `--statistics` to the compiler, like MuMiniZinc::execution_args::statistics. */
+    bool statistics;
+
+    /** The file where the results are cached between runs, like MuMiniZinc::execution_args::cache_path. */
+    std::filesystem::path cache_path;
+
+    /** The directory with the expected outputs of the original model, like MuMiniZinc::execution_args::golden_outputs_path. */
+    std::filesystem::path golden_outputs_path;
+
+    /** The directory where the outputs of the original model are written, like MuMiniZinc::execution_args::write_golden_outputs_path. */
+    std::filesystem::path write_golden_outputs_path;
+
+    /** The file where every execution of a mutant is recorded, like MuMiniZinc::execution_args::journal_path. */
+    std::filesystem::path journal_path;
+
+    /** Whether to take the results recorded in the journal, like MuMiniZinc::execution_args::resume. */
+    bool resume;
+
+    /** Whether SIGINT and SIGTERM stop the solvers instead of the process, like MuMiniZinc::execution_args::handle_interrupts. */
+    bool handle_interrupts;
+
+    /** The shard of the mutants to run, like MuMiniZinc::execution_args::shard_index. */
+    std::uint64_t shard_index;
+
+    /** The amount of shards the mutants are split into, like MuMiniZinc::execution_args::shard_count. */
+    std::uint64_t shard_count;
+
+    /** A shell command that starts a worker, like MuMiniZinc::execution_args::worker_command. */
+    std::string_view worker_command;
+
+    /** A command every execution is wrapped in, like MuMiniZinc::execution_args::launcher. */
+    std::span<const std::string> launcher;
+
+    /** Whether every execution is pinned to CPUs of its own, like MuMiniZinc::execution_args::pin_cpus. */
+    bool pin_cpus;
+
+    /** The maximum bytes of address space of every process of an execution, like MuMiniZinc::execution_args::memory_limit. */
+    std::uint64_t memory_limit;
+
+    /** The maximum CPU time of every process of an execution, like MuMiniZinc::execution_args::cpu_time_limit. */
+    std::chrono::seconds cpu_time_limit;
 };
 
 /**
@@ -299,6 +481,9 @@ struct run_mutants_args
  * Dumps the mutants and the normalized model to the filesystem.
  * This will not dump the mutation operators' statistics.
  *
+ * A mutant whose MuMiniZinc::Entry::mutated_item is known starts with a comment line with it, which
+ * MuMiniZinc::retrieve_mutants reads back and removes.
+ *
  * @param entries the mutants and the normalized model to dump.
  * @param directory the directory to dump the mutants to.
  *
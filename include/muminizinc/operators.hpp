@@ -2,6 +2,7 @@
 #define OPERATORS_HPP
 
 #include <array>       // std::array
+#include <cstddef>     // std::size_t
 #include <span>        // std::span
 #include <string_view> // std::string_view
 #include <utility>     // std::pair
@@ -68,6 +69,9 @@ public:
     /** Visitor for calls to functions. */
     void vCall(MiniZinc::Call* call);
 
+    /** Sets the position of the top-level item whose expression is visited next, among the printed items of the model. */
+    constexpr void item_index(std::size_t index) noexcept { m_item_index = index; }
+
 private:
     const MiniZinc::Model* m_model;
 
@@ -79,6 +83,8 @@ private:
 
     std::uint64_t m_location_counter {};
 
+    std::size_t m_item_index {};
+
     void perform_mutation(MiniZinc::BinOp* op, std::span<const MiniZinc::BinOpType> operators, std::string_view operator_name);
     void perform_mutation_unop(MiniZinc::BinOp* op);
     void perform_mutation_unop(MiniZinc::Call* call);
@@ -1,8 +1,9 @@
 #include <arguments.hpp>
 
-#include <algorithm>    // std::ranges::find_if
+#include <algorithm>    // std::ranges::find_if, std::ranges::stable_sort
 #include <array>        // std::array
 #include <charconv>     // std::from_chars
+#include <chrono>       // std::chrono::duration, std::chrono::seconds
 #include <cstdint>      // std::uint64_t
 #include <cstdlib>      // EXIT_SUCCESS
 #include <filesystem>   // std::filesystem::exists, std::filesystem::path
@@ -10,16 +11,19 @@
 #include <fstream>      // std::ofstream
 #include <functional>   // std::reference_wrapper
 #include <iostream>     // std::cout
-#include <iterator>     // std::ostreambuf_iterator
+#include <iterator>     // std::back_inserter, std::ostreambuf_iterator
+#include <limits>       // std::numeric_limits
+#include <map>          // std::map
 #include <optional>     // std::optional
-#include <print>        // std::println
+#include <print>        // std::print, std::println
 #include <ranges>       // std::views::enumerate, std::views::filter, std::views::split, std::ranges::to, std::views::transform
 #include <span>         // std::span
 #include <sstream>      // std::ostringstream
 #include <string>       // std::string
 #include <string_view>  // std::string_view
 #include <system_error> // std::errc
-#include <utility>      // std::to_underlying
+#include <tuple>        // std::tuple
+#include <utility>      // std::pair, std::to_underlying
 #include <variant>      // std::variant
 #include <vector>       // std::vector
 
@@ -29,9 +33,9 @@
 
 #include <muminizinc/build/config.hpp>            // build::project_version
 #include <muminizinc/case_insensitive_string.hpp> // ascii_ci_string_view
-#include <muminizinc/executor.hpp>                // BadVersion
+#include <muminizinc/executor.hpp>                // BadVersion, MuMiniZinc::run_worker
 #include <muminizinc/logging.hpp>                 // logging::code, logging::Color, logging::Style
-#include <muminizinc/mutation.hpp>                // MuMiniZinc::clear_mutant_output_folder, MuMiniZinc::EntryResult, MuMiniZinc::find_mutants, MuMiniZinc::find_mutants_args, MuMiniZinc::get_path_from_model_path, MuMiniZinc::run_mutants, MuMiniZinc::run_mutants_args
+#include <muminizinc/mutation.hpp>                // MuMiniZinc::clear_mutant_output_folder, MuMiniZinc::EntryResult, MuMiniZinc::find_mutants, MuMiniZinc::find_mutants_args, MuMiniZinc::get_path_from_model_path, MuMiniZinc::IOError, MuMiniZinc::run_mutants, MuMiniZinc::run_mutants_args
 #include <muminizinc/operators.hpp>               // MuMiniZinc::available_operators
 
 namespace
@@ -46,7 +50,10 @@ constexpr auto separator_arguments { ',' };
 
 #define DEFAULT_TIMEOUT_S 10
 
-constexpr std::uint64_t default_n_jobs { 0 }; // Unlimited jobs.
+constexpr std::uint64_t default_n_jobs { 0 }; // Determined from the available hardware threads.
+constexpr std::uint64_t default_io_threads { 1 };
+constexpr std::uint64_t default_max_output_size { 0 }; // No limit, as the original's output is needed as a whole.
+constexpr std::uint64_t default_max_error_size { 64 * 1024 };
 
 struct Option
 {
@@ -76,6 +83,8 @@ int analyse(std::span<const std::string_view> arguments);
 int run(std::span<const std::string_view> arguments);
 int normalise(std::span<const std::string_view> arguments);
 int clean(std::span<const std::string_view> arguments);
+int merge(std::span<const std::string_view> arguments);
+int worker(std::span<const std::string_view> arguments);
 int help_subcommand(std::span<const std::string_view> arguments);
 
 constexpr Option option_directory {
@@ -137,7 +146,13 @@ constexpr Option option_data {
 constexpr Option option_jobs {
     .name = "--jobs",
     .short_name = "-j",
-    .help = "The maximum number of concurrent execution jobs. A value of 0 (which is the default) makes it unlimited"
+    .help = "The maximum number of concurrent execution jobs. A value of 0 (which is the default) uses one per hardware thread, divided by the solver's `--parallel`"
+};
+
+constexpr Option option_io_threads {
+    .name = "--io-threads",
+    .short_name = {},
+    .help = "The number of threads that read and compare the output of the executions. By default it's 1, and 0 uses one per hardware thread"
 };
 
 constexpr Option option_output {
@@ -176,6 +191,138 @@ constexpr Option option_ignore_model_timestamp {
     .help = "Continue even if the model is newer than the mutants"
 };
 
+constexpr Option option_engine {
+    .name = "--engine",
+    .short_name = "-e",
+    .help = "`process` spawns the compiler for every execution (default), `in-process` flattens in helpers forked from this process, which only spawn the solver, `delta` reuses the original's FlatZinc for constraint mutants"
+};
+
+constexpr Option option_schedule {
+    .name = "--schedule",
+    .short_name = {},
+    .help = "`fifo` runs the mutants in order (default), `longest-first` starts with the data files the original model took longest with"
+};
+
+constexpr Option option_boost_tail {
+    .name = "--boost-tail",
+    .short_name = {},
+    .help = "Give the idle jobs to the last mutants as solver threads through `-p`. Only for solvers whose output does not depend on their threads"
+};
+
+constexpr Option option_vfork {
+    .name = "--vfork",
+    .short_name = {},
+    .help = "Spawn the compiler with vfork, so launching it does not get slower with many mutants in memory. Only on Unix systems"
+};
+
+constexpr Option option_timeouts_killed {
+    .name = "--timeouts-killed",
+    .short_name = {},
+    .help = "Count the mutants that only differ because of the time limit as dead in the summary, instead of on their own"
+};
+
+constexpr Option option_slowdown_factor {
+    .name = "--slowdown-factor",
+    .short_name = {},
+    .help = "Report the alive mutants that take at least this many times as long as the original model with the same data file"
+};
+
+constexpr Option option_statistics {
+    .name = "--statistics",
+    .short_name = {},
+    .help = "Pass `--statistics` to the compiler and report the statistics of every execution in the JSON output. They are not compared"
+};
+
+constexpr Option option_cache {
+    .name = "--cache",
+    .short_name = {},
+    .help = "The file where the results are cached between runs. The executions whose mutant, data, compiler arguments and compiler version have not changed are not run again"
+};
+
+constexpr Option option_golden_outputs {
+    .name = "--golden-outputs",
+    .short_name = {},
+    .help = "A directory with the outputs of the original model, named after the path of every data file followed by `.out`, to use instead of running it. Not compatible with `--schedule longest-first` and `--slowdown-factor`. Not used with `delta` or `--reuse-solutions`"
+};
+
+constexpr Option option_write_golden_outputs {
+    .name = "--write-golden-outputs",
+    .short_name = {},
+    .help = "A directory where the outputs of the original model are written, to be used later through `--golden-outputs`"
+};
+
+constexpr Option option_journal {
+    .name = "--journal",
+    .short_name = {},
+    .help = "A file where every finished execution is recorded as soon as it finishes. Interrupting the run with Ctrl+C stops the solvers and prints the partial results"
+};
+
+constexpr Option option_resume {
+    .name = "--resume",
+    .short_name = {},
+    .help = "Do not run again the executions recorded in the file given to `--journal`, and append the new ones to it"
+};
+
+constexpr Option option_shard {
+    .name = "--shard",
+    .short_name = {},
+    .help = "Only run the mutants of a shard, given as `i/N` with 1 <= i <= N. Every mutant belongs to a shard according to a hash of its name. The JSON output of the shards can be combined with `merge`"
+};
+
+constexpr Option option_worker_command {
+    .name = "--worker-command",
+    .short_name = {},
+    .help = "A shell command that starts a worker with the `worker` subcommand, like `ssh node{worker} muminizinc worker`, where `{worker}` is replaced by the index of the worker. As many workers as jobs are started, and every execution is sent to the first free worker. The executions of a worker that exits go to the rest. Only with the `process` engine, and not with `--pin-cpus`, `--shared-files` nor `--journal`"
+};
+
+constexpr Option option_launcher {
+    .name = "--launcher",
+    .short_name = {},
+    .help = "A command every execution is wrapped in, like `taskset -c {cpu}`, whose arguments can be quoted like in a shell. `{slot}` is replaced by the job slot of the execution, `{cpu}` by the CPUs of its slot and `{job}` by the number of the execution. The CPU pinning and the resource limits apply to the launcher, and to the compiler through it"
+};
+
+constexpr Option option_pin_cpus {
+    .name = "--pin-cpus",
+    .short_name = {},
+    .help = "Pin every execution to CPUs of its own, as many as threads are given to the solver, from the same NUMA node when possible. Only on Linux"
+};
+
+constexpr Option option_memory_limit {
+    .name = "--memory-limit",
+    .short_name = {},
+    .help = "The maximum memory in MiB every process of an execution can allocate. The executions that run out of it are reported as over the limit instead of exhausting the memory of the system. A value of 0 (which is the default) means no limit"
+};
+
+constexpr Option option_cpu_time_limit {
+    .name = "--cpu-time-limit",
+    .short_name = {},
+    .help = "The maximum CPU time in seconds of every process of an execution, including the flattening, after which it is killed and reported as over the limit. A value of 0 (which is the default) means no limit"
+};
+
+constexpr Option option_reuse_solutions {
+    .name = "--reuse-solutions",
+    .short_name = {},
+    .help = "Evaluate output mutants on the original's solutions instead of solving them again"
+};
+
+constexpr Option option_max_output_size {
+    .name = "--max-output-size",
+    .short_name = {},
+    .help = "The maximum bytes of output kept from the original model. A value of 0 (which is the default) means no limit"
+};
+
+constexpr Option option_shared_files {
+    .name = "--shared-files",
+    .short_name = {},
+    .help = "Write every mutant once to a directory in memory and pass its path to the compiler, instead of piping it for every data file"
+};
+
+constexpr Option option_max_error_size {
+    .name = "--max-error-size",
+    .short_name = {},
+    .help = "The maximum bytes of error output kept from an execution. By default it's 65536 bytes, and 0 means no limit"
+};
+
 constexpr std::array analyse_parameters {
     option_help,
     option_color,
@@ -203,12 +350,35 @@ constexpr std::array run_parameters {
     option_timeout,
     option_data,
     option_jobs,
+    option_io_threads,
     option_output,
     option_include,
     option_mutant,
     option_json,
     option_ignore_version_check,
     option_ignore_model_timestamp,
+    option_engine,
+    option_schedule,
+    option_boost_tail,
+    option_vfork,
+    option_timeouts_killed,
+    option_slowdown_factor,
+    option_statistics,
+    option_cache,
+    option_golden_outputs,
+    option_write_golden_outputs,
+    option_journal,
+    option_resume,
+    option_shard,
+    option_worker_command,
+    option_launcher,
+    option_pin_cpus,
+    option_memory_limit,
+    option_cpu_time_limit,
+    option_reuse_solutions,
+    option_max_output_size,
+    option_max_error_size,
+    option_shared_files,
 };
 
 constexpr std::array normalise_parameters {
@@ -223,6 +393,21 @@ constexpr std::array clean_parameters {
     option_color
 };
 
+constexpr std::array worker_parameters {
+    option_compiler_path,
+    option_help,
+    option_color,
+    option_vfork,
+    option_launcher
+};
+
+constexpr std::array merge_parameters {
+    option_help,
+    option_color,
+    option_json,
+    option_timeouts_killed
+};
+
 constexpr Command command_applyall {
     .option {
         .name = "applyall",
@@ -288,6 +473,24 @@ constexpr Command command_clean {
     .options = clean_parameters
 };
 
+constexpr Command command_merge {
+    .option {
+        .name = "merge",
+        .short_name = {},
+        .help = "Combines the JSON output of several runs, like the shards of a run, into a single result" },
+    .operation = merge,
+    .options = merge_parameters
+};
+
+constexpr Command command_worker {
+    .option {
+        .name = "worker",
+        .short_name = {},
+        .help = "Runs the executions sent by `run --worker-command` through the standard input, and writes their results to the standard output" },
+    .operation = worker,
+    .options = worker_parameters
+};
+
 constexpr Command command_hidden_clear {
     .option = {
         .name = "clear",
@@ -334,6 +537,8 @@ constexpr std::array commands {
     command_applyall,
     command_run,
     command_clean,
+    command_merge,
+    command_worker,
     command_normalise,
     command_hidden_normalize,
     command_hidden_clear,
@@ -369,6 +574,297 @@ nlohmann::json get_statistics_json(const MuMiniZinc::EntryResult& entries)
     };
 };
 
+/** Converts the statistics of an execution to a JSON object, keeping the values that are numbers as numbers. */
+nlohmann::json get_solver_statistics_json(std::span<const std::pair<std::string, std::string>> statistics)
+{
+    auto json = nlohmann::json::object();
+
+    for (const auto& [name, value] : statistics)
+    {
+        double number {};
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+
+        if (ec == std::errc {} && ptr == value.data() + value.size())
+            json[name] = number;
+        else if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            json[name] = value.substr(1, value.size() - 2);
+        else
+            json[name] = value;
+    }
+
+    return json;
+}
+
+/**
+ * Returns how many times as long as the original model a mutant has taken with the same data file. The CPU
+ * time is compared if it has been measured for both, as it depends less on the rest of the running jobs,
+ * and the wall time otherwise. Returns zero if the original has not taken any time.
+ */
+double get_slowdown(const MuMiniZinc::Entry::Usage& mutant, const MuMiniZinc::Entry::Usage& original) noexcept
+{
+    const auto is_measured = mutant.user_time.has_value() && mutant.system_time.has_value() && original.user_time.has_value() && original.system_time.has_value();
+
+    const auto [mutant_time, original_time] = is_measured
+        ? std::pair { *mutant.user_time + *mutant.system_time, *original.user_time + *original.system_time }
+        : std::pair { mutant.wall_time, original.wall_time };
+
+    if (original_time == std::chrono::microseconds::zero())
+        return 0;
+
+    return static_cast<double>(mutant_time.count()) / static_cast<double>(original_time.count());
+}
+
+/** Returns how much a result of a mutant with a data file weighs when deciding the status of the mutant. */
+constexpr int get_status_precedence(MuMiniZinc::Entry::Status status) noexcept
+{
+    switch (status)
+    {
+    case MuMiniZinc::Entry::Status::Dead:
+        return 0;
+    case MuMiniZinc::Entry::Status::Timeout:
+        return 1;
+    case MuMiniZinc::Entry::Status::LimitExceeded:
+        return 2;
+    case MuMiniZinc::Entry::Status::Interrupted:
+        return 3;
+    case MuMiniZinc::Entry::Status::Alive:
+    case MuMiniZinc::Entry::Status::Invalid:
+        break;
+    }
+
+    return 4;
+}
+
+/** The amount of mutants with every status, reported at the end of a run. */
+struct Summary
+{
+    std::size_t n_invalid {};
+    std::size_t n_alive {};
+    std::size_t n_dead {};
+    std::size_t n_timeout {};
+    std::size_t n_interrupted {};
+    std::size_t n_limit_exceeded {};
+
+    /** Whether the mutants that only differ because of the time limit are counted as dead too. */
+    bool timeouts_killed {};
+
+    /** Counts a mutant, given its results with every data file. */
+    void add(std::span<const MuMiniZinc::Entry::Status> results)
+    {
+        auto status = MuMiniZinc::Entry::Status::Dead;
+
+        // An alive or invalid result decides the status of the mutant. Otherwise, an interrupted execution
+        // leaves it undecided, and a timeout or an exceeded limit is only the mutant's status if every other
+        // data file has made it dead.
+        for (const auto value : results)
+        {
+            if (get_status_precedence(value) > get_status_precedence(status))
+                status = value;
+        }
+
+        switch (status)
+        {
+        case MuMiniZinc::Entry::Status::Alive:
+            ++n_alive;
+            break;
+        case MuMiniZinc::Entry::Status::Dead:
+            ++n_dead;
+            break;
+        case MuMiniZinc::Entry::Status::Invalid:
+            ++n_invalid;
+            break;
+        case MuMiniZinc::Entry::Status::Timeout:
+            ++n_timeout;
+
+            if (timeouts_killed)
+                ++n_dead;
+
+            break;
+        case MuMiniZinc::Entry::Status::Interrupted:
+            ++n_interrupted;
+            break;
+        case MuMiniZinc::Entry::Status::LimitExceeded:
+            ++n_limit_exceeded;
+            break;
+        }
+    }
+
+    [[nodiscard]] nlohmann::json to_json() const
+    {
+        return nlohmann::json::object({ { "invalid", n_invalid }, { "alive", n_alive }, { "dead", n_dead }, { "timeout", n_timeout }, { "interrupted", n_interrupted }, { "limit_exceeded", n_limit_exceeded } });
+    }
+
+    void print() const
+    {
+        std::println("{2:s}{3:s}Summary:{0:s}\n  Invalid:  {1:s}{4:d}{0:s}\n  Alive:    {1:s}{5:d}{0:s}\n  Dead:     {1:s}{6:d}{0:s}\n  Timeout:  {1:s}{7:d}{0:s}{8:s}", logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), logging::code(logging::Style::Bold), logging::code(logging::Style::Underline), n_invalid, n_alive, n_dead, n_timeout, timeouts_killed ? " (counted as dead)" : "");
+
+        if (n_limit_exceeded != 0)
+            std::println("  Over limits: {1:s}{2:d}{0:s}", logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), n_limit_exceeded);
+
+        if (n_interrupted != 0)
+            std::println("  Interrupted: {1:s}{2:d}{0:s}", logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), n_interrupted);
+    }
+};
+
+/**
+ * The width of the column of names in the matrix of results. The names of the mutants are the name of
+ * the model followed by their operator, location and occurrence.
+ */
+[[nodiscard]] constexpr std::size_t get_name_width(std::string_view model_name) noexcept
+{
+    return model_name.size() + 10;
+}
+
+/** Returns the name of the model of a mutant, without its operator, location and occurrence. */
+[[nodiscard]] constexpr std::string_view get_model_name(std::string_view mutant_name) noexcept
+{
+    auto model_name = mutant_name;
+
+    for (std::size_t i {}; i < 3; ++i)
+    {
+        const auto separator = model_name.rfind('-');
+
+        if (separator == std::string_view::npos)
+            return mutant_name;
+
+        model_name = model_name.substr(0, separator);
+    }
+
+    return model_name;
+}
+
+/**
+ * Orders the names of the mutants by their model and operator, and then by the numbers of their location
+ * and occurrence, so `model-ROR-2-0` comes before `model-ROR-10-0`.
+ */
+struct MutantNameOrder
+{
+    [[nodiscard]] bool operator()(std::string_view name, std::string_view other_name) const noexcept
+    {
+        return get_key(name) < get_key(other_name);
+    }
+
+private:
+    [[nodiscard]] static std::tuple<std::string_view, std::uint64_t, std::uint64_t, std::string_view> get_key(std::string_view name) noexcept
+    {
+        const auto occurrence_separator = name.rfind('-');
+        const auto location_separator = occurrence_separator == std::string_view::npos || occurrence_separator == 0 ? std::string_view::npos : name.rfind('-', occurrence_separator - 1);
+
+        std::uint64_t location {};
+        std::uint64_t occurrence {};
+
+        if (location_separator == std::string_view::npos
+            || std::from_chars(name.data() + location_separator + 1, name.data() + occurrence_separator, location).ec != std::errc {}
+            || std::from_chars(name.data() + occurrence_separator + 1, name.data() + name.size(), occurrence).ec != std::errc {})
+            return { name, 0, 0, name };
+
+        return { name.substr(0, location_separator), location, occurrence, name };
+    }
+};
+
+/** Writes a row of the matrix of results: the name of a mutant and its result with every data file. */
+void print_results_row(std::ostreambuf_iterator<char> output, std::string_view name, std::size_t name_width, std::span<const MuMiniZinc::Entry::Status> results)
+{
+    std::format_to(output, "{:<{}}   ", name, name_width);
+
+    for (const auto value : results)
+        std::format_to(output, "{:d} ", std::to_underlying(value));
+
+    std::format_to(output, "\n");
+}
+
+/** Adds an alive mutant to the text of the report of slow mutants. */
+void append_slow_mutant(std::string& text, std::string_view name, std::string_view data_file, double slowdown)
+{
+    const auto label = data_file.empty() ? std::string { name } : std::format("{:s} ({:s})", name, data_file);
+    std::format_to(std::back_inserter(text), "  {:s}: {:s}{:.2f}x{:s}\n", label, logging::code(logging::Color::Blue), slowdown, logging::code(logging::Style::Reset));
+}
+
+/** Prints the report of the alive mutants that are at least `slowdown_factor` times as slow as the original model. */
+void print_slow_mutants(double slowdown_factor, std::string_view text)
+{
+    if (text.empty())
+        std::println("\nNo alive mutant is {:g} times as slow as the original model.", slowdown_factor);
+    else
+        std::print("\n{1:s}{2:s}Alive mutants at least {3:g} times as slow as the original model:{0:s}\n{4:s}", logging::code(logging::Style::Reset), logging::code(logging::Style::Bold), logging::code(logging::Style::Underline), slowdown_factor, text);
+}
+
+/**
+ * Splits a launcher command into its arguments, and replaces the first one with the path of its executable.
+ * The arguments are separated by spaces, like in a shell: spaces can be kept by quoting them with `'`, whose
+ * contents are taken as they are, or with `"`, where a backslash escapes `"` and `\\`. Outside of quotes, a
+ * backslash escapes the next character.
+ *
+ * @throws BadArgument if the command is empty, a quote is not closed or its executable cannot be found.
+ */
+[[nodiscard]] std::vector<std::string> parse_launcher(std::string_view command_name, std::string_view launcher)
+{
+    std::vector<std::string> launcher_arguments;
+
+    std::string argument;
+    bool has_argument { false };
+    char quote {};
+
+    for (std::size_t i {}; i < launcher.size(); ++i)
+    {
+        const auto character = launcher[i];
+
+        if (quote == '\'')
+        {
+            if (character == '\'')
+                quote = {};
+            else
+                argument.push_back(character);
+        }
+        else if (quote == '"')
+        {
+            if (character == '"')
+                quote = {};
+            else if (character == '\\' && i + 1 < launcher.size() && (launcher[i + 1] == '"' || launcher[i + 1] == '\\'))
+                argument.push_back(launcher[++i]);
+            else
+                argument.push_back(character);
+        }
+        else if (character == ' ')
+        {
+            if (has_argument)
+                launcher_arguments.push_back(std::exchange(argument, {}));
+
+            has_argument = false;
+        }
+        else
+        {
+            has_argument = true;
+
+            if (character == '\'' || character == '"')
+                quote = character;
+            else if (character == '\\' && i + 1 < launcher.size())
+                argument.push_back(launcher[++i]);
+            else
+                argument.push_back(character);
+        }
+    }
+
+    if (quote != char {})
+        throw BadArgument { std::format("{:s}: {:s}: Missing the closing `{:c}`.", command_name, option_launcher.name, quote) };
+
+    if (has_argument)
+        launcher_arguments.push_back(std::move(argument));
+
+    if (launcher_arguments.empty())
+        throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", command_name, option_launcher.name) };
+
+    const std::filesystem::path executable_from_user { launcher_arguments.front() };
+    const auto executable = std::filesystem::exists(executable_from_user) ? executable_from_user : boost::process::environment::find_executable(executable_from_user);
+
+    if (executable.empty())
+        throw BadArgument { std::format("{:s}: {:s}: Could not find the executable `{:s}{:s}{:s}`.", command_name, option_launcher.name, logging::code(logging::Color::Blue), launcher_arguments.front(), logging::code(logging::Style::Reset)) };
+
+    launcher_arguments.front() = logging::path_to_utf8(executable);
+
+    return launcher_arguments;
+}
+
 void print_statistics(const MuMiniZinc::EntryResult& entries)
 {
     if (entries.mutants().empty())
@@ -677,6 +1173,30 @@ int run(std::span<const std::string_view> arguments)
     bool check_compiler_version { true };
     bool check_model_last_modified_time { true };
     bool is_json { false };
+    auto engine { MuMiniZinc::ExecutionEngine::Process };
+    auto scheduling { MuMiniZinc::SchedulingPolicy::Fifo };
+    bool boost_tail_threads { false };
+    bool use_vfork { false };
+    bool timeouts_killed { false };
+    double slowdown_factor {};
+    bool statistics { false };
+    std::filesystem::path cache_path;
+    std::filesystem::path golden_outputs_path;
+    std::filesystem::path write_golden_outputs_path;
+    std::filesystem::path journal_path;
+    bool resume { false };
+    std::uint64_t shard_index {};
+    std::uint64_t shard_count {};
+    std::string_view worker_command;
+    std::vector<std::string> launcher;
+    bool pin_cpus { false };
+    std::uint64_t memory_limit {};
+    std::uint64_t cpu_time_limit_seconds {};
+    std::uint64_t io_threads { default_io_threads };
+    bool reuse_original_solutions { false };
+    std::uint64_t max_output_size { default_max_output_size };
+    std::uint64_t max_error_size { default_max_error_size };
+    bool shared_files { false };
 
     std::uint64_t timeout_seconds { DEFAULT_TIMEOUT_S };
 #undef DEFAULT_TIMEOUT_S
@@ -694,6 +1214,63 @@ int run(std::span<const std::string_view> arguments)
         }
         else if (arguments[i] == option_ignore_version_check)
             check_compiler_version = false;
+        else if (arguments[i] == option_reuse_solutions)
+            reuse_original_solutions = true;
+        else if (arguments[i] == option_shared_files)
+            shared_files = true;
+        else if (arguments[i] == option_boost_tail)
+            boost_tail_threads = true;
+        else if (arguments[i] == option_vfork)
+            use_vfork = true;
+        else if (arguments[i] == option_timeouts_killed)
+            timeouts_killed = true;
+        else if (arguments[i] == option_statistics)
+            statistics = true;
+        else if (arguments[i] == option_resume)
+            resume = true;
+        else if (arguments[i] == option_pin_cpus)
+            pin_cpus = true;
+        else if (arguments[i] == option_engine)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_engine.name) };
+
+            static constexpr auto value_process { "process"sv };
+            static constexpr auto value_in_process { "in-process"sv };
+            static constexpr auto value_delta { "delta"sv };
+
+            const auto value { arguments[i + 1] };
+
+            if (value == value_process)
+                engine = MuMiniZinc::ExecutionEngine::Process;
+            else if (value == value_in_process)
+                engine = MuMiniZinc::ExecutionEngine::InProcess;
+            else if (value == value_delta)
+                engine = MuMiniZinc::ExecutionEngine::Delta;
+            else
+                throw BadArgument { std::format(R"({:s}: {:s}: Unknown value `{:s}{:s}{:s}`. Valid values are "{:s}", "{:s}" and "{:s}".)", arguments.front(), option_engine.name, logging::code(logging::Color::Blue), value, logging::code(logging::Style::Reset), value_process, value_in_process, value_delta) };
+
+            ++i;
+        }
+        else if (arguments[i] == option_schedule)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_schedule.name) };
+
+            static constexpr auto value_fifo { "fifo"sv };
+            static constexpr auto value_longest_first { "longest-first"sv };
+
+            const auto value { arguments[i + 1] };
+
+            if (value == value_fifo)
+                scheduling = MuMiniZinc::SchedulingPolicy::Fifo;
+            else if (value == value_longest_first)
+                scheduling = MuMiniZinc::SchedulingPolicy::LongestFirst;
+            else
+                throw BadArgument { std::format(R"({:s}: {:s}: Unknown value `{:s}{:s}{:s}`. Valid values are "{:s}" and "{:s}".)", arguments.front(), option_schedule.name, logging::code(logging::Color::Blue), value, logging::code(logging::Style::Reset), value_fifo, value_longest_first) };
+
+            ++i;
+        }
         else if (arguments[i] == option_mutant)
         {
             if (i + 1 >= arguments.size())
@@ -739,6 +1316,142 @@ int run(std::span<const std::string_view> arguments)
 
             ++i;
         }
+        else if (arguments[i] == option_io_threads)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_io_threads.name) };
+
+            const auto parameter { arguments[i + 1] };
+            const auto [_, ec] = std::from_chars(parameter.data(), parameter.data() + parameter.size(), io_threads);
+
+            if (ec == std::errc::invalid_argument)
+                throw BadArgument { std::format("{:s}: {:s}: Invalid number.", arguments.front(), option_io_threads.name) };
+
+            if (ec == std::errc::result_out_of_range)
+                throw BadArgument { std::format("{:s}: {:s}: The specified number is too big.", arguments.front(), option_io_threads.name) };
+
+            ++i;
+        }
+        else if (arguments[i] == option_memory_limit || arguments[i] == option_cpu_time_limit)
+        {
+            const auto is_memory_limit = arguments[i] == option_memory_limit;
+            const auto& option = is_memory_limit ? option_memory_limit : option_cpu_time_limit;
+
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option.name) };
+
+            static constexpr std::uint64_t mebibyte { 1024 * 1024 };
+
+            const auto parameter { arguments[i + 1] };
+            auto& value = is_memory_limit ? memory_limit : cpu_time_limit_seconds;
+            const auto [_, ec] = std::from_chars(parameter.data(), parameter.data() + parameter.size(), value);
+
+            if (ec == std::errc::invalid_argument)
+                throw BadArgument { std::format("{:s}: {:s}: Invalid number.", arguments.front(), option.name) };
+
+            // The memory limit must fit in bytes, and the CPU time limit in std::chrono::seconds.
+            const auto max_value = is_memory_limit ? std::numeric_limits<std::uint64_t>::max() / mebibyte : static_cast<std::uint64_t>(std::chrono::seconds::max().count());
+
+            if (ec == std::errc::result_out_of_range || value > max_value)
+                throw BadArgument { std::format("{:s}: {:s}: The specified number is too big.", arguments.front(), option.name) };
+
+            // The limit is given in MiB, and kept in bytes.
+            if (is_memory_limit)
+                value *= mebibyte;
+
+            ++i;
+        }
+        else if (arguments[i] == option_max_output_size || arguments[i] == option_max_error_size)
+        {
+            const auto& option = arguments[i] == option_max_output_size ? option_max_output_size : option_max_error_size;
+
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option.name) };
+
+            const auto parameter { arguments[i + 1] };
+            const auto [_, ec] = std::from_chars(parameter.data(), parameter.data() + parameter.size(), arguments[i] == option_max_output_size ? max_output_size : max_error_size);
+
+            if (ec == std::errc::invalid_argument)
+                throw BadArgument { std::format("{:s}: {:s}: Invalid number.", arguments.front(), option.name) };
+
+            if (ec == std::errc::result_out_of_range)
+                throw BadArgument { std::format("{:s}: {:s}: The specified number is too big.", arguments.front(), option.name) };
+
+            ++i;
+        }
+        else if (arguments[i] == option_cache || arguments[i] == option_golden_outputs || arguments[i] == option_write_golden_outputs || arguments[i] == option_journal)
+        {
+            const std::array<std::pair<const Option*, std::filesystem::path*>, 4> path_options {
+                { { &option_cache, &cache_path },
+                    { &option_golden_outputs, &golden_outputs_path },
+                    { &option_write_golden_outputs, &write_golden_outputs_path },
+                    { &option_journal, &journal_path } }
+            };
+
+            const auto [option, path] = *std::ranges::find_if(path_options, [&](const auto& path_option)
+                { return arguments[i] == *path_option.first; });
+
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option->name) };
+
+            *path = arguments[i + 1];
+
+            ++i;
+        }
+        else if (arguments[i] == option_launcher)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_launcher.name) };
+
+            launcher = parse_launcher(arguments.front(), arguments[i + 1]);
+
+            ++i;
+        }
+        else if (arguments[i] == option_worker_command)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_worker_command.name) };
+
+            worker_command = arguments[i + 1];
+
+            ++i;
+        }
+        else if (arguments[i] == option_shard)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_shard.name) };
+
+            const auto parameter { arguments[i + 1] };
+            const auto separator = parameter.find('/');
+
+            const auto parse = [](std::string_view number, std::uint64_t& value)
+            {
+                const auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), value);
+                return ec == std::errc {} && ptr == number.data() + number.size();
+            };
+
+            std::uint64_t index {};
+
+            if (separator == std::string_view::npos || !parse(parameter.substr(0, separator), index) || !parse(parameter.substr(separator + 1), shard_count) || index == 0 || index > shard_count)
+                throw BadArgument { std::format("{:s}: {:s}: Invalid shard. It must be `i/N`, with 1 <= i <= N.", arguments.front(), option_shard.name) };
+
+            shard_index = index - 1;
+
+            ++i;
+        }
+        else if (arguments[i] == option_slowdown_factor)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_slowdown_factor.name) };
+
+            const auto parameter { arguments[i + 1] };
+            const auto [ptr, ec] = std::from_chars(parameter.data(), parameter.data() + parameter.size(), slowdown_factor);
+
+            if (ec != std::errc {} || ptr != parameter.data() + parameter.size() || slowdown_factor <= 0)
+                throw BadArgument { std::format("{:s}: {:s}: Invalid factor. It must be a positive number.", arguments.front(), option_slowdown_factor.name) };
+
+            ++i;
+        }
         else if (arguments[i] == option_data)
         {
             if (i + 1 >= arguments.size())
@@ -840,11 +1553,39 @@ int run(std::span<const std::string_view> arguments)
     if (model_path.empty())
         throw BadArgument { std::format("{:s}: Missing model path.", arguments.front()) };
 
+    if (!worker_command.empty() && (engine != MuMiniZinc::ExecutionEngine::Process || reuse_original_solutions))
+        throw BadArgument { std::format("{:s}: {:s}: Argument only compatible with the `process` engine, without `{:s}{:s}{:s}`.", arguments.front(), option_worker_command.name, logging::code(logging::Color::Blue), option_reuse_solutions.name, logging::code(logging::Style::Reset)) };
+
+    // The workers run the executions by themselves, maybe on other machines, and cannot be interrupted.
+    if (!worker_command.empty())
+    {
+        const auto check_worker_option = [&arguments](const Option& option, bool is_used)
+        {
+            if (is_used)
+                throw BadArgument { std::format("{:s}: {:s}: Argument not compatible with `{:s}{:s}{:s}`.", arguments.front(), option.name, logging::code(logging::Color::Blue), option_worker_command.name, logging::code(logging::Style::Reset)) };
+        };
+
+        check_worker_option(option_pin_cpus, pin_cpus);
+        check_worker_option(option_shared_files, shared_files);
+        check_worker_option(option_journal, !journal_path.empty());
+    }
+
+    // The original model is not run with golden outputs, so the time it takes is not known.
+    if (!golden_outputs_path.empty() && engine != MuMiniZinc::ExecutionEngine::Delta && !reuse_original_solutions)
+    {
+        if (scheduling == MuMiniZinc::SchedulingPolicy::LongestFirst)
+            throw BadArgument { std::format("{:s}: {:s}: Argument not compatible with `{:s}{:s}{:s}`, which does not run the original model.", arguments.front(), option_schedule.name, logging::code(logging::Color::Blue), option_golden_outputs.name, logging::code(logging::Style::Reset)) };
+
+        if (slowdown_factor > 0)
+            throw BadArgument { std::format("{:s}: {:s}: Argument not compatible with `{:s}{:s}{:s}`, which does not run the original model.", arguments.front(), option_slowdown_factor.name, logging::code(logging::Color::Blue), option_golden_outputs.name, logging::code(logging::Style::Reset)) };
+    }
+
     const std::filesystem::path executable_from_user { compiler_path };
 
     const auto executable = std::filesystem::exists(executable_from_user) ? executable_from_user : boost::process::environment::find_executable(executable_from_user);
 
-    if (executable.empty())
+    // The in-process engine does not need the compiler.
+    if (executable.empty() && engine != MuMiniZinc::ExecutionEngine::InProcess)
         throw BadArgument { std::format("{:s}: Could not find the executable `{:s}{:s}{:s}`. Please add it to $PATH or provide its path using `{:s}{:s}{:s}`.", arguments.front(), logging::code(logging::Color::Blue), logging::path_to_utf8(executable_from_user), logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), option_compiler_path.name, logging::code(logging::Style::Reset)) };
 
     std::optional<std::ofstream> output_file;
@@ -913,6 +1654,13 @@ int run(std::span<const std::string_view> arguments)
     if (entries.mutants().empty())
         throw std::runtime_error { std::format("{:s}: Could not find any mutants to run.", arguments.front()) };
 
+    if (resume && journal_path.empty())
+        throw BadArgument { std::format("{:s}: {:s}: The option `{:s}{:s}{:s}` is required.", arguments.front(), option_resume.name, logging::code(logging::Color::Blue), option_journal.name, logging::code(logging::Style::Reset)) };
+
+    // Interrupting the run prints the partial results only with a journal, which keeps them for resuming it.
+    // Otherwise, the signals keep their default action.
+    const auto handle_interrupts = !journal_path.empty();
+
     const MuMiniZinc::run_mutants_args parameters {
         .entry_result = entries,
         .compiler_path = executable,
@@ -922,12 +1670,33 @@ int run(std::span<const std::string_view> arguments)
         .timeout { timeout_seconds },
         .n_jobs = n_jobs,
         .check_compiler_version = check_compiler_version,
-        .output_log = is_json ? logging::output {} : logging::output { std::cout }
+        .output_log = is_json ? logging::output {} : logging::output { std::cout },
+        .engine = engine,
+        .reuse_original_solutions = reuse_original_solutions,
+        .max_output_size = max_output_size,
+        .max_error_size = max_error_size,
+        .shared_files = shared_files,
+        .scheduling = scheduling,
+        .boost_tail_threads = boost_tail_threads,
+        .use_vfork = use_vfork,
+        .io_threads = io_threads,
+        .statistics = statistics,
+        .cache_path = std::move(cache_path),
+        .golden_outputs_path = std::move(golden_outputs_path),
+        .write_golden_outputs_path = std::move(write_golden_outputs_path),
+        .journal_path = std::move(journal_path),
+        .resume = resume,
+        .handle_interrupts = handle_interrupts,
+        .shard_index = shard_index,
+        .shard_count = shard_count,
+        .worker_command = worker_command,
+        .launcher = launcher,
+        .pin_cpus = pin_cpus,
+        .memory_limit = memory_limit,
+        .cpu_time_limit = std::chrono::seconds { cpu_time_limit_seconds }
     };
 
-    std::size_t n_invalid {};
-    std::size_t n_alive {};
-    std::size_t n_dead {};
+    Summary summary { .timeouts_killed = timeouts_killed };
 
     const std::ostreambuf_iterator<char> output_stream { output_file.has_value() ? *output_file : std::cout };
 
@@ -948,51 +1717,71 @@ int run(std::span<const std::string_view> arguments)
     }
 
     auto entries_array = nlohmann::json::array();
+    auto slow_array = nlohmann::json::array();
+    std::string slow_text;
 
     for (const auto& entry : entries.mutants())
     {
         if (entry.results.empty())
             continue;
 
-        if (!is_json || (is_json && output_file.has_value()))
-            std::format_to(output_stream, "{:<{}}   ", entry.name, entries.model_name().size() + 10);
+        // Mutants with the same output that make the model much slower show which constraints matter to the solver.
+        for (std::size_t index {}; slowdown_factor > 0 && index < entry.results.size() && index < entry.usages.size() && index < entries.original_usages().size(); ++index)
+        {
+            if (entry.results[index] != MuMiniZinc::Entry::Status::Alive)
+                continue;
 
-        auto status = MuMiniZinc::Entry::Status::Dead;
+            const auto slowdown = get_slowdown(entry.usages[index], entries.original_usages()[index]);
 
-        auto json_results = nlohmann::json::array();
-        for (const auto value : entry.results)
-        {
-            const auto value_underlying = std::to_underlying(value);
+            if (slowdown < slowdown_factor)
+                continue;
 
-            if (!is_json || (is_json && output_file.has_value()))
-                std::format_to(output_stream, "{:d} ", value_underlying);
+            const std::string_view data_file = data_files.empty() ? std::string_view {} : data_files[index];
 
             if (is_json)
-                json_results.emplace_back(value_underlying);
-
-            if (status == MuMiniZinc::Entry::Status::Dead)
-                status = value;
+                slow_array.emplace_back(nlohmann::json::object({ { "mutant", entry.name }, { "data_file", data_file }, { "slowdown", slowdown } }));
+            else
+                append_slow_mutant(slow_text, entry.name, data_file, slowdown);
         }
 
-        if (is_json)
-            entries_array.emplace_back(nlohmann::json::object({ { "mutant", entry.name },
-                { "results", std::move(json_results) } }));
+        if (!is_json || (is_json && output_file.has_value()))
+            print_results_row(output_stream, entry.name, get_name_width(entries.model_name()), entry.results);
 
-        switch (status)
+        summary.add(entry.results);
+
+        if (is_json)
         {
-        case MuMiniZinc::Entry::Status::Alive:
-            ++n_alive;
-            break;
-        case MuMiniZinc::Entry::Status::Dead:
-            ++n_dead;
-            break;
-        case MuMiniZinc::Entry::Status::Invalid:
-            ++n_invalid;
-            break;
-        }
+            auto json_results = nlohmann::json::array();
 
-        if (!is_json || (is_json && output_file.has_value()))
-            std::format_to(output_stream, "\n");
+            for (const auto value : entry.results)
+                json_results.emplace_back(std::to_underlying(value));
+
+            const auto to_seconds = [](std::chrono::microseconds time)
+            { return std::chrono::duration<double> { time }.count(); };
+
+            // The resources that have not been measured are null.
+            const auto to_json = [](const auto& value)
+            { return value.has_value() ? nlohmann::json(*value) : nlohmann::json(nullptr); };
+
+            auto json_usages = nlohmann::json::array();
+
+            for (const auto& usage : entry.usages)
+            {
+                auto json_usage = nlohmann::json::object({ { "wall_time", to_seconds(usage.wall_time) },
+                    { "user_time", to_json(usage.user_time.transform(to_seconds)) },
+                    { "system_time", to_json(usage.system_time.transform(to_seconds)) },
+                    { "max_rss", to_json(usage.max_rss) } });
+
+                if (statistics)
+                    json_usage.emplace("statistics", get_solver_statistics_json(usage.statistics));
+
+                json_usages.emplace_back(std::move(json_usage));
+            }
+
+            entries_array.emplace_back(nlohmann::json::object({ { "mutant", entry.name },
+                { "results", std::move(json_results) },
+                { "usages", std::move(json_usages) } }));
+        }
     }
 
     if (!is_json && !output_file.has_value())
@@ -1002,13 +1791,21 @@ int run(std::span<const std::string_view> arguments)
     {
         const nlohmann::json json {
             { "results", std::move(entries_array) },
-            { "summary", { { "invalid", n_invalid }, { "alive", n_alive }, { "dead", n_dead } } }
+            { "summary", summary.to_json() },
+            { "slow", std::move(slow_array) },
+            { "slowdown_factor", slowdown_factor }
         };
 
         std::println("{}", json.dump());
     }
     else
-        std::println("{2:s}{3:s}Summary:{0:s}\n  Invalid:  {1:s}{4:d}{0:s}\n  Alive:    {1:s}{5:d}{0:s}\n  Dead:     {1:s}{6:d}{0:s}", logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), logging::code(logging::Style::Bold), logging::code(logging::Style::Underline), n_invalid, n_alive, n_dead);
+        summary.print();
+
+    if (!is_json && summary.n_interrupted != 0 && !parameters.journal_path.empty())
+        std::println("\nThe run has been interrupted. To finish it, run it again with `{1:s}{2:s}{0:s}`.", logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), option_resume.name);
+
+    if (!is_json && slowdown_factor > 0)
+        print_slow_mutants(slowdown_factor, slow_text);
 
     return EXIT_SUCCESS;
 }
@@ -1104,6 +1901,191 @@ int clean(std::span<const std::string_view> arguments)
     return EXIT_SUCCESS;
 }
 
+int merge(std::span<const std::string_view> arguments)
+{
+    std::vector<std::string_view> input_paths;
+    bool is_json { false };
+    bool timeouts_killed { false };
+
+    for (std::size_t i { 1 }; i < arguments.size(); ++i)
+    {
+        if (arguments[i] == option_json)
+            is_json = true;
+        else if (arguments[i] == option_timeouts_killed)
+            timeouts_killed = true;
+        else if (arguments[i] == option_help)
+            return help_subcommand(arguments.subspan(0, 1));
+        else
+            input_paths.push_back(arguments[i]);
+    }
+
+    if (input_paths.empty())
+        throw BadArgument { std::format("{:s}: Missing the results to merge.", arguments.front()) };
+
+    // The mutants are sorted by name, so the result does not depend on the order of the shards.
+    std::map<std::string, std::pair<nlohmann::json, std::vector<MuMiniZinc::Entry::Status>>, MutantNameOrder> mutants;
+    std::vector<std::pair<std::string, nlohmann::json>> slow_entries;
+    std::optional<std::size_t> n_data_files;
+    std::optional<double> slowdown_factor;
+
+    for (const auto input_path : input_paths)
+    {
+        std::ifstream file { std::filesystem::path { input_path } };
+
+        if (!file.is_open())
+            throw MuMiniZinc::IOError { std::format("{:s}: Could not open the file `{:s}{:s}{:s}`.", arguments.front(), logging::code(logging::Color::Blue), input_path, logging::code(logging::Style::Reset)) };
+
+        try
+        {
+            auto json = nlohmann::json::parse(file);
+
+            for (auto& entry : json.at("results"))
+            {
+                auto name = entry.at("mutant").get<std::string>();
+
+                std::vector<MuMiniZinc::Entry::Status> results;
+
+                for (const auto& value : entry.at("results"))
+                {
+                    const auto value_underlying = value.get<std::uint64_t>();
+
+                    if (value_underlying > std::to_underlying(MuMiniZinc::Entry::Status::LimitExceeded))
+                        throw std::runtime_error { std::format("{:s}: The mutant `{:s}` has an unknown result in `{:s}`.", arguments.front(), name, input_path) };
+
+                    results.push_back(static_cast<MuMiniZinc::Entry::Status>(value_underlying));
+                }
+
+                if (n_data_files.value_or(results.size()) != results.size())
+                    throw std::runtime_error { std::format("{:s}: The results of `{:s}` have been run with a different amount of data files.", arguments.front(), input_path) };
+
+                n_data_files = results.size();
+
+                if (mutants.contains(name))
+                    throw std::runtime_error { std::format("{:s}: The mutant `{:s}` is in more than one of the results.", arguments.front(), name) };
+
+                mutants.emplace(std::move(name), std::pair { std::move(entry), std::move(results) });
+            }
+
+            if (const auto slow = json.find("slow"); slow != json.end())
+            {
+                for (auto& entry : *slow)
+                    slow_entries.emplace_back(entry.at("mutant").get<std::string>(), std::move(entry));
+            }
+
+            const auto file_slowdown_factor = json.value("slowdown_factor", 0.0);
+
+            if (slowdown_factor.value_or(file_slowdown_factor) != file_slowdown_factor)
+                throw std::runtime_error { std::format("{:s}: The results of `{:s}` have been run with a different slowdown factor.", arguments.front(), input_path) };
+
+            slowdown_factor = file_slowdown_factor;
+        }
+        catch (const nlohmann::json::exception&)
+        {
+            throw std::runtime_error { std::format("{:s}: The file `{:s}` does not contain the JSON output of a run.", arguments.front(), input_path) };
+        }
+    }
+
+    Summary summary { .timeouts_killed = timeouts_killed };
+
+    for (const auto& [name, mutant] : mutants)
+        summary.add(mutant.second);
+
+    // The slow mutants of every shard follow the order of the mutants too.
+    std::ranges::stable_sort(slow_entries, MutantNameOrder {}, [](const auto& entry) -> std::string_view
+        { return entry.first; });
+
+    if (is_json)
+    {
+        auto entries_array = nlohmann::json::array();
+
+        for (auto& [name, mutant] : mutants)
+            entries_array.push_back(std::move(mutant.first));
+
+        auto slow_array = nlohmann::json::array();
+
+        for (auto& [name, entry] : slow_entries)
+            slow_array.push_back(std::move(entry));
+
+        const nlohmann::json json {
+            { "results", std::move(entries_array) },
+            { "summary", summary.to_json() },
+            { "slow", std::move(slow_array) },
+            { "slowdown_factor", slowdown_factor.value_or(0) }
+        };
+
+        std::println("{}", json.dump());
+
+        return EXIT_SUCCESS;
+    }
+
+    // The matrix and the reports are printed like run does.
+    const std::ostreambuf_iterator<char> output_stream { std::cout };
+
+    for (const auto& [name, mutant] : mutants)
+        print_results_row(output_stream, name, get_name_width(get_model_name(name)), mutant.second);
+
+    std::println();
+    summary.print();
+
+    if (slowdown_factor.value_or(0) > 0)
+    {
+        std::string slow_text;
+
+        for (const auto& [name, entry] : slow_entries)
+            append_slow_mutant(slow_text, name, entry.value("data_file", std::string {}), entry.value("slowdown", 0.0));
+
+        print_slow_mutants(*slowdown_factor, slow_text);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int worker(std::span<const std::string_view> arguments)
+{
+    std::string_view compiler_path { "minizinc" };
+    bool use_vfork { false };
+    std::vector<std::string> launcher;
+
+    for (std::size_t i { 1 }; i < arguments.size(); ++i)
+    {
+        if (arguments[i] == option_compiler_path)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_compiler_path.name) };
+
+            compiler_path = arguments[i + 1];
+
+            ++i;
+        }
+        else if (arguments[i] == option_vfork)
+            use_vfork = true;
+        else if (arguments[i] == option_launcher)
+        {
+            if (i + 1 >= arguments.size())
+                throw BadArgument { std::format("{:s}: {:s}: Missing parameter.", arguments.front(), option_launcher.name) };
+
+            launcher = parse_launcher(arguments.front(), arguments[i + 1]);
+
+            ++i;
+        }
+        else if (arguments[i] == option_help)
+            return help_subcommand(arguments.subspan(0, 1));
+        else
+            throw BadArgument { std::format("{:s}: Unknown parameter `{:s}{:s}{:s}`.", arguments.front(), logging::code(logging::Color::Blue), arguments[i], logging::code(logging::Style::Reset)) };
+    }
+
+    const std::filesystem::path executable_from_user { compiler_path };
+
+    const auto executable = std::filesystem::exists(executable_from_user) ? executable_from_user : boost::process::environment::find_executable(executable_from_user);
+
+    if (executable.empty())
+        throw BadArgument { std::format("{:s}: Could not find the executable `{:s}{:s}{:s}`. Please add it to $PATH or provide its path using `{:s}{:s}{:s}`.", arguments.front(), logging::code(logging::Color::Blue), logging::path_to_utf8(executable_from_user), logging::code(logging::Style::Reset), logging::code(logging::Color::Blue), option_compiler_path.name, logging::code(logging::Style::Reset)) };
+
+    MuMiniZinc::run_worker({ .compiler_path = executable, .input = std::cin, .output = std::cout, .use_vfork = use_vfork, .launcher = launcher });
+
+    return EXIT_SUCCESS;
+}
+
 int print_version()
 {
     std::println("{:s} {:s}\nBuilt with MiniZinc {:s}", MuMiniZinc::build::project_fancy_name, MuMiniZinc::build::project_version, MuMiniZinc::minizinc_version);
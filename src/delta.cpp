@@ -0,0 +1,836 @@
+#include <muminizinc/delta.hpp>
+
+#include <algorithm>     // std::max, std::min, std::ranges::contains, std::ranges::count, std::ranges::find, std::ranges::sort
+#include <array>         // std::array
+#include <charconv>      // std::from_chars
+#include <cstddef>       // std::size_t
+#include <format>        // std::format
+#include <memory>        // std::make_unique
+#include <optional>      // std::nullopt, std::optional
+#include <ranges>        // std::ranges::views::enumerate
+#include <span>          // std::span
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <system_error>  // std::errc
+#include <unordered_map> // std::unordered_map
+#include <unordered_set> // std::unordered_set
+#include <utility>       // std::move, std::pair
+#include <vector>        // std::vector
+
+namespace
+{
+
+using namespace std::string_view_literals;
+
+constexpr auto path_annotation { "mzn_path(\""sv };
+constexpr auto defines_var_annotation { "defines_var("sv };
+constexpr auto whitespace { " \t\r\n"sv };
+
+/** Keywords that start top-level MiniZinc items which are not declarations. */
+constexpr std::array non_declaration_keywords { "annotation"sv, "enum"sv, "function"sv, "include"sv, "predicate"sv, "test"sv, "type"sv };
+
+constexpr bool is_identifier_start(char character) noexcept
+{
+    return character == '_' || (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+}
+
+constexpr bool is_identifier_character(char character) noexcept
+{
+    return is_identifier_start(character) || (character >= '0' && character <= '9');
+}
+
+constexpr std::string_view trim(std::string_view view) noexcept
+{
+    const auto first = view.find_first_not_of(whitespace);
+
+    if (first == std::string_view::npos)
+        return {};
+
+    return view.substr(first, view.find_last_not_of(whitespace) - first + 1);
+}
+
+/** Whether an item starts with a keyword, as a whole identifier. */
+constexpr bool starts_with_keyword(std::string_view item, std::string_view keyword) noexcept
+{
+    return item.starts_with(keyword) && (item.size() == keyword.size() || !is_identifier_character(item[keyword.size()]));
+}
+
+/** Returns the position right after the string literal that starts at `position`. */
+constexpr std::size_t skip_string(std::string_view text, std::size_t position) noexcept
+{
+    for (++position; position < text.size() && text[position] != '"'; ++position)
+    {
+        if (text[position] == '\\')
+            ++position;
+    }
+
+    return std::min(position + 1, text.size());
+}
+
+/** Calls `function` with every identifier of `text`, as a view to it. Strings and numbers are skipped. */
+template<typename Function>
+void for_each_identifier(std::string_view text, Function&& function)
+{
+    std::size_t i {};
+
+    while (i < text.size())
+    {
+        if (text[i] == '"')
+            i = skip_string(text, i);
+        else if (is_identifier_character(text[i]))
+        {
+            const auto start = i;
+
+            while (i < text.size() && is_identifier_character(text[i]))
+                ++i;
+
+            // Tokens starting with a digit are numbers, like `1e5`.
+            if (is_identifier_start(text[start]))
+                function(text.substr(start, i - start));
+        }
+        else
+            ++i;
+    }
+}
+
+/**
+ * Finds the first position of `character` outside of strings and brackets.
+ * For `:`, annotation separators (`::`) are not taken into account.
+ */
+constexpr std::size_t find_top_level(std::string_view text, char character) noexcept
+{
+    std::size_t depth {};
+
+    for (std::size_t i {}; i < text.size(); ++i)
+    {
+        const auto current = text[i];
+
+        if (current == '"')
+            i = skip_string(text, i) - 1;
+        else if (current == '(' || current == '[' || current == '{')
+            ++depth;
+        else if ((current == ')' || current == ']' || current == '}') && depth > 0)
+            --depth;
+        else if (depth == 0 && current == character)
+        {
+            if (character != ':' || i + 1 >= text.size() || text[i + 1] != ':')
+                return i;
+
+            ++i;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/** Returns the position of the parenthesis that closes the one at `position`. */
+constexpr std::size_t find_closing_parenthesis(std::string_view text, std::size_t position) noexcept
+{
+    std::size_t depth {};
+
+    for (; position < text.size(); ++position)
+    {
+        if (text[position] == '"')
+            position = skip_string(text, position) - 1;
+        else if (text[position] == '(')
+            ++depth;
+        else if (text[position] == ')' && --depth == 0)
+            return position;
+    }
+
+    return text.size() - 1;
+}
+
+/** The type-inst of a declaration, like `var 1..3` or `array [1..2] of int`. */
+constexpr std::string_view get_type(std::string_view declaration) noexcept
+{
+    return trim(declaration.substr(0, find_top_level(declaration, ':')));
+}
+
+/** The value assigned by a declaration, or an empty view if there is none. */
+constexpr std::string_view get_value(std::string_view declaration) noexcept
+{
+    const auto equals = find_top_level(declaration, '=');
+
+    if (equals == std::string_view::npos)
+        return {};
+
+    return trim(declaration.substr(equals + 1));
+}
+
+/** The elements of the array literal assigned by a declaration, or nothing if there is none. */
+std::vector<std::string_view> get_array_elements(std::string_view declaration)
+{
+    const auto value = get_value(declaration);
+
+    if (value.size() < 2 || value.front() != '[' || value.back() != ']')
+        return {};
+
+    std::vector<std::string_view> elements;
+
+    auto remaining = value.substr(1, value.size() - 2);
+
+    while (!trim(remaining).empty())
+    {
+        const auto comma = find_top_level(remaining, ',');
+
+        elements.push_back(trim(remaining.substr(0, comma)));
+
+        if (comma == std::string_view::npos)
+            break;
+
+        remaining = remaining.substr(comma + 1);
+    }
+
+    return elements;
+}
+
+MuMiniZinc::FlatItem parse_declaration(std::string_view text)
+{
+    MuMiniZinc::FlatItem item { .kind = MuMiniZinc::FlatItem::Kind::Declaration, .text = text };
+
+    const auto colon = find_top_level(text, ':');
+
+    if (colon == std::string_view::npos)
+    {
+        item.kind = MuMiniZinc::FlatItem::Kind::Other;
+        return item;
+    }
+
+    const auto rest = text.substr(colon + 1);
+    const auto name_start = std::min(rest.find_first_not_of(whitespace), rest.size());
+    auto name_end = name_start;
+
+    while (name_end < rest.size() && is_identifier_character(rest[name_end]))
+        ++name_end;
+
+    item.name = rest.substr(name_start, name_end - name_start);
+
+    for_each_identifier(text.substr(0, colon), [&item](std::string_view identifier)
+        {
+            if (identifier == "var"sv)
+                item.is_variable = true; });
+
+    for_each_identifier(rest, [&item](std::string_view identifier)
+        {
+            if (identifier == "var_is_introduced"sv)
+                item.is_introduced = true; });
+
+    return item;
+}
+
+MuMiniZinc::FlatItem parse_constraint(std::string_view text)
+{
+    MuMiniZinc::FlatItem item { .kind = MuMiniZinc::FlatItem::Kind::Constraint, .text = text };
+
+    if (const auto position = text.find(path_annotation); position != std::string_view::npos)
+    {
+        // The outermost element of a path is `file|first line|first column|last line|last column|...`.
+        auto element = text.substr(position + path_annotation.size());
+        element = element.substr(0, element.find_first_of(";\""sv));
+
+        const auto separator = element.find('|');
+        item.path_file = element.substr(0, separator);
+
+        MuMiniZinc::Span span;
+        auto rest = separator == std::string_view::npos ? std::string_view {} : element.substr(separator + 1);
+
+        for (auto* const field : { &span.first_line, &span.first_column, &span.last_line, &span.last_column })
+        {
+            const auto [end, ec] = std::from_chars(rest.data(), rest.data() + rest.size(), *field);
+
+            // A path without its whole span cannot be attributed to an item.
+            if (ec != std::errc {})
+                return item;
+
+            rest.remove_prefix(std::min(static_cast<std::size_t>(end - rest.data()) + 1, rest.size()));
+        }
+
+        item.path_span = span;
+    }
+
+    if (const auto position = text.find(defines_var_annotation); position != std::string_view::npos)
+    {
+        const auto name = text.substr(position + defines_var_annotation.size());
+        item.defined_variable = trim(name.substr(0, name.find(')')));
+    }
+
+    return item;
+}
+
+/** The line and column, starting at one, of a position of `model`. */
+std::pair<std::size_t, std::size_t> get_location(std::string_view model, std::size_t position) noexcept
+{
+    const auto before = model.substr(0, position);
+    const auto line_start = before.find_last_of('\n');
+
+    return { 1 + static_cast<std::size_t>(std::ranges::count(before, '\n')), line_start == std::string_view::npos ? position + 1 : position - line_start };
+}
+
+/** The span of an item that is a view to `model`. */
+MuMiniZinc::Span get_span(std::string_view model, std::string_view item) noexcept
+{
+    const auto offset = static_cast<std::size_t>(item.data() - model.data());
+    const auto [first_line, first_column] = get_location(model, offset);
+    const auto [last_line, last_column] = get_location(model, offset + std::max(item.size(), std::size_t { 1 }) - 1);
+
+    return { .first_line = first_line, .first_column = first_column, .last_line = last_line, .last_column = last_column };
+}
+
+/**
+ * Whether the constraint comes from the given span of a model file. Its path must be within the span,
+ * and the end of the path may be one column past it, where the semicolon of the item is.
+ */
+bool comes_from(const MuMiniZinc::FlatItem& constraint, std::string_view file, const MuMiniZinc::Span& span) noexcept
+{
+    const auto& path = constraint.path_span;
+
+    return constraint.path_file == file
+        && std::pair { path.first_line, path.first_column } >= std::pair { span.first_line, span.first_column }
+        && std::pair { path.last_line, path.last_column } <= std::pair { span.last_line, span.last_column + 1 };
+}
+
+/**
+ * Whether a declaration has the same type and value in both models. The elements of arrays
+ * are compared through their own declarations, as their names depend on the flattening.
+ */
+bool has_same_declaration(const MuMiniZinc::FlatModel& model, const MuMiniZinc::FlatModel& other_model, std::string_view name)
+{
+    const auto* declaration = model.find_declaration(name);
+    const auto* other_declaration = other_model.find_declaration(name);
+
+    if (declaration == nullptr || other_declaration == nullptr || get_type(declaration->text) != get_type(other_declaration->text))
+        return false;
+
+    const auto elements = get_array_elements(declaration->text);
+    const auto other_elements = get_array_elements(other_declaration->text);
+
+    if (elements.empty() && other_elements.empty())
+        return get_value(declaration->text) == get_value(other_declaration->text);
+
+    if (elements.size() != other_elements.size())
+        return false;
+
+    for (std::size_t i {}; i < elements.size(); ++i)
+    {
+        const auto* element = model.find_declaration(elements[i]);
+        const auto* other_element = other_model.find_declaration(other_elements[i]);
+
+        // Fixed elements are written as literals.
+        if (element == nullptr || other_element == nullptr)
+        {
+            if (element != other_element || elements[i] != other_elements[i])
+                return false;
+
+            continue;
+        }
+
+        if (get_type(element->text) != get_type(other_element->text) || get_value(element->text) != get_value(other_element->text))
+            return false;
+    }
+
+    return true;
+}
+
+/** Replaces the identifiers of `text` that appear in `names`. */
+std::string rename(std::string_view text, const std::unordered_map<std::string_view, std::string>& names)
+{
+    std::string result;
+    result.reserve(text.size());
+
+    std::size_t last {};
+
+    for_each_identifier(text, [&](std::string_view identifier)
+        {
+            const auto it = names.find(identifier);
+
+            if (it == names.end() || it->second == identifier)
+                return;
+
+            const auto position = static_cast<std::size_t>(identifier.data() - text.data());
+
+            result.append(text.substr(last, position - last));
+            result.append(it->second);
+
+            last = position + identifier.size(); });
+
+    result.append(text.substr(last));
+
+    return result;
+}
+
+/** Removes every `:: name` and `:: name(...)` annotation from an item. */
+std::string remove_annotation(std::string_view text, std::string_view name)
+{
+    std::string result;
+    result.reserve(text.size());
+
+    std::size_t last {};
+
+    for (std::size_t i {}; i + 1 < text.size(); ++i)
+    {
+        if (text[i] == '"')
+        {
+            i = skip_string(text, i) - 1;
+            continue;
+        }
+
+        if (text[i] != ':' || text[i + 1] != ':')
+            continue;
+
+        auto end = std::min(text.find_first_not_of(whitespace, i + 2), text.size());
+
+        if (!text.substr(end).starts_with(name) || (end + name.size() < text.size() && is_identifier_character(text[end + name.size()])))
+            continue;
+
+        end += name.size();
+
+        if (end < text.size() && text[end] == '(')
+            end = find_closing_parenthesis(text, end) + 1;
+
+        auto start = i;
+
+        while (start > last && whitespace.contains(text[start - 1]))
+            --start;
+
+        result.append(text.substr(last, start - last));
+
+        last = end;
+        i = end - 1;
+    }
+
+    result.append(text.substr(last));
+
+    return result;
+}
+
+/**
+ * Whether flattening the mutated item along with the declarations has left the FlatZinc of the declarations
+ * as it is, once the constraints of the item and the variables only they have introduced are left out. A
+ * common subexpression that the item shares with the declarations would otherwise change their FlatZinc,
+ * which the replacement does not carry over. The paths are not compared, as they name different files.
+ */
+bool keeps_declarations(const MuMiniZinc::FlatModel& fragment_model, std::span<const MuMiniZinc::FlatItem* const> fragment, const MuMiniZinc::FlatModel& declarations)
+{
+    const auto declaration_items = declarations.items();
+    std::size_t next {};
+
+    for (const auto& item : fragment_model.items())
+    {
+        if (std::ranges::contains(fragment, &item))
+            continue;
+
+        if (item.kind == MuMiniZinc::FlatItem::Kind::Declaration && item.is_introduced && declarations.find_declaration(item.name) == nullptr)
+            continue;
+
+        if (next == declaration_items.size() || remove_annotation(item.text, "mzn_path"sv) != remove_annotation(declaration_items[next].text, "mzn_path"sv))
+            return false;
+
+        ++next;
+    }
+
+    return next == declaration_items.size();
+}
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+std::vector<std::string_view> split_items(std::string_view model)
+{
+    std::vector<std::string_view> items;
+
+    std::size_t depth {};
+    std::size_t start {};
+
+    for (std::size_t i {}; i < model.size(); ++i)
+    {
+        const auto character = model[i];
+
+        if (character == '"' || character == '\'')
+        {
+            // Skip string literals and quoted identifiers.
+            for (++i; i < model.size() && model[i] != character; ++i)
+            {
+                if (model[i] == '\\')
+                    ++i;
+            }
+        }
+        else if (character == '%')
+            i = std::min(model.find('\n', i), model.size());
+        else if (character == '/' && i + 1 < model.size() && model[i + 1] == '*')
+            i = std::min(model.find("*/"sv, i + 2), model.size() - 1) + 1;
+        else if (character == '(' || character == '[' || character == '{')
+            ++depth;
+        else if ((character == ')' || character == ']' || character == '}') && depth > 0)
+            --depth;
+        else if (character == ';' && depth == 0)
+        {
+            if (const auto item = trim(model.substr(start, i - start)); !item.empty())
+                items.push_back(item);
+
+            start = i + 1;
+        }
+    }
+
+    if (start < model.size())
+    {
+        if (const auto item = trim(model.substr(start)); !item.empty())
+            items.push_back(item);
+    }
+
+    return items;
+}
+
+MutatedItem::Kind get_item_kind(std::string_view item) noexcept
+{
+    if (starts_with_keyword(item, "constraint"sv))
+        return MutatedItem::Kind::Constraint;
+
+    if (starts_with_keyword(item, "solve"sv))
+        return MutatedItem::Kind::Solve;
+
+    if (starts_with_keyword(item, "output"sv))
+        return MutatedItem::Kind::Output;
+
+    return MutatedItem::Kind::Other;
+}
+
+std::optional<MutatedItem> find_mutated_item(std::string_view normalized_model, std::string_view mutant, std::size_t index)
+{
+    const auto original_items = split_items(normalized_model);
+    const auto mutant_items = split_items(mutant);
+
+    // The position comes from the printed model, which the mutant must have been printed like.
+    if (original_items.size() != mutant_items.size() || index >= original_items.size() || original_items[index] == mutant_items[index])
+        return std::nullopt;
+
+    return MutatedItem { .kind = get_item_kind(original_items[index]), .index = index, .original = original_items[index], .mutated = mutant_items[index] };
+}
+
+} // namespace MuMiniZinc::detail
+
+namespace MuMiniZinc
+{
+
+FlatModel::FlatModel(std::string contents) :
+    m_contents { std::make_unique<const std::string>(std::move(contents)) }
+{
+    const auto items = detail::split_items(*m_contents);
+
+    m_items.reserve(items.size());
+
+    for (const auto text : items)
+    {
+        FlatItem item;
+
+        switch (detail::get_item_kind(text))
+        {
+            case detail::MutatedItem::Kind::Constraint:
+                item = parse_constraint(text);
+                break;
+            case detail::MutatedItem::Kind::Solve:
+                item = FlatItem { .kind = FlatItem::Kind::Solve, .text = text };
+                break;
+            default:
+                item = text.starts_with("predicate"sv) ? FlatItem { .kind = FlatItem::Kind::Other, .text = text } : parse_declaration(text);
+        }
+
+        if (item.kind == FlatItem::Kind::Declaration)
+            m_declarations.emplace(item.name, m_items.size());
+
+        m_items.push_back(item);
+    }
+}
+
+const FlatItem* FlatModel::find_declaration(std::string_view name) const noexcept
+{
+    const auto it = m_declarations.find(name);
+
+    return it == m_declarations.end() ? nullptr : &m_items[it->second];
+}
+
+std::vector<std::string_view> find_variable_declarations(std::span<const std::string_view> items)
+{
+    std::vector<std::string_view> variables;
+
+    for (const auto item : items)
+    {
+        if (detail::get_item_kind(item) != detail::MutatedItem::Kind::Other)
+            continue;
+
+        std::string_view keyword;
+
+        for_each_identifier(item.substr(0, item.find_first_of(whitespace)), [&keyword](std::string_view identifier)
+            {
+                if (keyword.empty())
+                    keyword = identifier; });
+
+        if (std::ranges::contains(non_declaration_keywords, keyword))
+            continue;
+
+        const auto declaration = parse_declaration(item);
+
+        if (declaration.kind == FlatItem::Kind::Declaration && declaration.is_variable && !declaration.name.empty())
+            variables.push_back(declaration.name);
+    }
+
+    return variables;
+}
+
+std::optional<std::string> replace_flattened_item(const FlattenedItem& original, const FlattenedItem& mutated, const FlatModel& declarations, std::span<const std::string_view> variables)
+{
+    const auto& base = original.flat_model;
+    const auto& fragment_model = mutated.flat_model;
+
+    // The variables mentioned by both items must keep their names and domains, as a constraint
+    // absorbed into a domain cannot be told apart from the rest of the model.
+    for (const auto& [item, flat_model] : { std::pair { original.item, &base }, std::pair { mutated.item, &fragment_model } })
+    {
+        bool same_domains = true;
+
+        for_each_identifier(item, [&](std::string_view identifier)
+            {
+                if (same_domains && std::ranges::contains(variables, identifier) && !has_same_declaration(*flat_model, declarations, identifier))
+                    same_domains = false; });
+
+        if (!same_domains)
+            return std::nullopt;
+    }
+
+    const auto original_span = get_span(original.model, original.item);
+    const auto mutated_span = get_span(mutated.model, mutated.item);
+
+    // Find the constraints contributed by the original item.
+    const auto base_items = base.items();
+
+    std::vector<bool> is_removed(base_items.size());
+    std::unordered_set<std::string_view> removed_definitions;
+
+    for (std::size_t i {}; i < base_items.size(); ++i)
+    {
+        const auto& item = base_items[i];
+
+        if (item.kind != FlatItem::Kind::Constraint)
+            continue;
+
+        // A constraint that cannot be attributed to an item may come from the original one.
+        if (item.path_span.first_line == 0)
+            return std::nullopt;
+
+        if (comes_from(item, original.file, original_span))
+        {
+            is_removed[i] = true;
+
+            if (!item.defined_variable.empty())
+                removed_definitions.insert(item.defined_variable);
+        }
+    }
+
+    // The paths may not name the model as expected, and the constraints of the original item would then be kept.
+    if (std::ranges::find(is_removed, true) == is_removed.end())
+        return std::nullopt;
+
+    std::unordered_set<std::string_view> kept_references;
+
+    for (std::size_t i {}; i < base_items.size(); ++i)
+    {
+        if (is_removed[i])
+            continue;
+
+        for_each_identifier(base_items[i].text, [&](std::string_view identifier)
+            {
+                if (base_items[i].kind != FlatItem::Kind::Declaration || identifier != base_items[i].name)
+                    kept_references.insert(identifier); });
+    }
+
+    // The variables introduced by the removed constraints can only be removed if nothing else uses them,
+    // while the variables of the model just lose their definition.
+    std::unordered_set<std::string_view> removed_declarations;
+    std::unordered_set<std::string_view> lost_definitions;
+
+    for (const auto name : removed_definitions)
+    {
+        const auto* declaration = base.find_declaration(name);
+
+        if (declaration == nullptr || !declaration->is_introduced)
+            lost_definitions.insert(name);
+        else if (kept_references.contains(name))
+            return std::nullopt;
+        else
+            removed_declarations.insert(name);
+    }
+
+    // Find the constraints contributed by the mutated item.
+    std::vector<const FlatItem*> fragment;
+    std::unordered_set<std::string_view> fragment_definitions;
+
+    for (const auto& item : fragment_model.items())
+    {
+        if (item.kind != FlatItem::Kind::Constraint)
+            continue;
+
+        if (item.path_span.first_line == 0)
+            return std::nullopt;
+
+        if (comes_from(item, mutated.file, mutated_span))
+        {
+            fragment.push_back(&item);
+
+            if (!item.defined_variable.empty())
+                fragment_definitions.insert(item.defined_variable);
+        }
+    }
+
+    if (!keeps_declarations(fragment_model, fragment, declarations))
+        return std::nullopt;
+
+    // The elements of the arrays of the model are introduced with different names in every flattening.
+    std::unordered_map<std::string_view, std::pair<std::string_view, std::size_t>> element_positions;
+
+    for (const auto& item : fragment_model.items())
+    {
+        if (item.kind != FlatItem::Kind::Declaration || item.is_introduced)
+            continue;
+
+        for (const auto [index, element] : std::ranges::views::enumerate(get_array_elements(item.text)))
+            element_positions.emplace(element, std::pair { item.name, static_cast<std::size_t>(index) });
+    }
+
+    // Match the identifiers used by the mutated item with the ones of the original model.
+    // Variables introduced by the mutated item are given new names.
+    std::unordered_map<std::string_view, std::string> names;
+    std::unordered_set<std::string_view> new_names;
+    std::vector<const FlatItem*> new_declarations;
+
+    std::vector<std::string_view> pending;
+
+    const auto add_pending = [&pending](std::string_view text)
+    {
+        for_each_identifier(text, [&pending](std::string_view identifier)
+            { pending.push_back(identifier); });
+    };
+
+    for (const auto* item : fragment)
+        add_pending(item->text);
+
+    while (!pending.empty())
+    {
+        const auto identifier = pending.back();
+        pending.pop_back();
+
+        if (names.contains(identifier))
+            continue;
+
+        const auto* declaration = fragment_model.find_declaration(identifier);
+
+        // Predicates, annotations and keywords are kept as they are.
+        if (declaration == nullptr)
+            continue;
+
+        if (!declaration->is_introduced)
+        {
+            if (base.find_declaration(identifier) == nullptr)
+                return std::nullopt;
+
+            names.emplace(identifier, std::string { identifier });
+        }
+        else if (const auto position = element_positions.find(identifier); position != element_positions.end())
+        {
+            const auto* array = base.find_declaration(position->second.first);
+
+            if (array == nullptr)
+                return std::nullopt;
+
+            const auto elements = get_array_elements(array->text);
+
+            if (position->second.second >= elements.size())
+                return std::nullopt;
+
+            names.emplace(identifier, std::string { elements[position->second.second] });
+        }
+        else if (!declaration->is_variable || fragment_definitions.contains(identifier))
+        {
+            names.emplace(identifier, std::format("X_DELTA_{:d}_", new_names.size()));
+            new_names.insert(identifier);
+            new_declarations.push_back(declaration);
+
+            add_pending(declaration->text);
+        }
+        else
+            return std::nullopt;
+    }
+
+    // Keep the order of the declarations, as they may depend on each other.
+    std::ranges::sort(new_declarations);
+
+    std::string merged;
+
+    bool added_declarations = false;
+    bool added_fragment = false;
+
+    const auto add_declarations = [&]
+    {
+        for (const auto* declaration : new_declarations)
+            merged.append(rename(declaration->text, names)).append(";\n");
+
+        added_declarations = true;
+    };
+
+    // The mutated constraints are placed where the original ones were, so the solver finds them in the same order.
+    const auto add_fragment = [&]
+    {
+        for (const auto* constraint : fragment)
+        {
+            auto text = rename(constraint->text, names);
+
+            // Variables of the original model may already be defined by another constraint.
+            if (!constraint->defined_variable.empty() && !new_names.contains(constraint->defined_variable))
+                text = remove_annotation(text, "defines_var"sv);
+
+            merged.append(text).append(";\n");
+        }
+
+        added_fragment = true;
+    };
+
+    for (std::size_t i {}; i < base_items.size(); ++i)
+    {
+        const auto& item = base_items[i];
+
+        if (!added_declarations && (item.kind == FlatItem::Kind::Constraint || item.kind == FlatItem::Kind::Solve))
+            add_declarations();
+
+        if (is_removed[i])
+        {
+            if (!added_fragment)
+                add_fragment();
+
+            continue;
+        }
+
+        if (!added_fragment && item.kind == FlatItem::Kind::Solve)
+            add_fragment();
+
+        if (item.kind == FlatItem::Kind::Declaration && removed_declarations.contains(item.name))
+            continue;
+
+        if (item.kind == FlatItem::Kind::Declaration && lost_definitions.contains(item.name))
+            merged.append(remove_annotation(item.text, "is_defined_var"sv));
+        else
+            merged.append(item.text);
+
+        merged.append(";\n");
+    }
+
+    if (!added_declarations)
+        add_declarations();
+
+    if (!added_fragment)
+        add_fragment();
+
+    return merged;
+}
+
+} // namespace MuMiniZinc
@@ -1,144 +1,124 @@
 #include <muminizinc/executor.hpp>
 
-#include <algorithm>   // std::max
-#include <chrono>      // std::chrono::seconds
+#include <algorithm>   // std::max, std::ranges::all_of, std::ranges::contains, std::ranges::fill, std::ranges::stable_sort
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::milliseconds, std::chrono::seconds
+#include <cstddef>     // std::size_t
 #include <cstdint>     // std::uint64_t
 #include <cstdlib>     // EXIT_SUCCESS
-#include <filesystem>  // std::filesystem::path
+#include <deque>       // std::deque
+#include <filesystem>  // std::filesystem::create_directories, std::filesystem::path
 #include <format>      // std::format
-#include <memory>      // std::make_unique
-#include <queue>       // std::queue
+#include <functional>  // std::identity, std::ranges::greater, std::ranges::less
+#include <numeric>     // std::ranges::iota
+#include <optional>    // std::optional
 #include <ranges>      // std::ranges::views::enumerate
 #include <span>        // std::span
-#include <string>      // std::string
+#include <string>      // std::string, std::to_string
 #include <string_view> // std::string_view
-#include <type_traits> // std::is_same_v
-#include <utility>     // std::move
+#include <thread>      // std::thread::hardware_concurrency
+#include <utility>     // std::pair, std::to_underlying
 #include <vector>      // std::vector
 
 #include <boost/asio/buffer.hpp>         // boost::asio::dynamic_buffer
-#include <boost/asio/error.hpp>          // boost::asio::error::eof
 #include <boost/asio/io_context.hpp>     // boost::asio::io_context
 #include <boost/asio/read.hpp>           // boost::asio::read
 #include <boost/asio/readable_pipe.hpp>  // boost::asio::readable_pipe
-#include <boost/asio/writable_pipe.hpp>  // boost::asio::writable_pipe
-#include <boost/asio/write.hpp>          // boost::asio::write
 #include <boost/process/v2/process.hpp>  // boost::process::process
 #include <boost/process/v2/stdio.hpp>    // boost::process::process_stdio
 #include <boost/system/error_code.hpp>   // boost::system::error_code
 #include <boost/utility/string_view.hpp> // boost::string_view
 
-#include <muminizinc/case_insensitive_string.hpp> // ascii_ci_string_view
-#include <muminizinc/logging.hpp>                 // logging::code, logging::color_support::get, logging::Style, logging::output
-#include <muminizinc/mutation.hpp>                // MuMiniZinc::Entry
+#include <muminizinc/logging.hpp>  // logging::code, logging::Color, logging::output, logging::path_to_utf8, logging::Style
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry, MuMiniZinc::minizinc_version_full
+
+#include <executor/coordinator.hpp>   // MuMiniZinc::detail::Coordinator
+#include <executor/files.hpp>         // MuMiniZinc::detail::read_file, MuMiniZinc::detail::ScratchDirectory, MuMiniZinc::detail::write_file
+#include <executor/hasher.hpp>        // MuMiniZinc::detail::Hasher
+#include <executor/in_process.hpp>    // MuMiniZinc::detail::run_in_process
+#include <executor/job.hpp>           // MuMiniZinc::detail::MutantJob, MuMiniZinc::detail::OriginalJob, MuMiniZinc::detail::Progress, MuMiniZinc::detail::StageJob, MuMiniZinc::detail::strip_statistics
+#include <executor/journal.hpp>       // MuMiniZinc::detail::Journal
+#include <executor/process.hpp>       // MuMiniZinc::detail::get_default_n_jobs
+#include <executor/result_cache.hpp>  // MuMiniZinc::detail::ResultCache
+#include <executor/scheduler.hpp>     // MuMiniZinc::detail::Scheduler
+#include <executor/staged_runner.hpp> // MuMiniZinc::detail::StagedRunner
 
 namespace
 {
 
-struct OriginalJob
+using namespace MuMiniZinc::detail;
+
+/**
+ * Orders the jobs of the mutants by the time the original model took with their data file, longest first.
+ * The jobs with the same data file keep their order.
+ *
+ * @param jobs the jobs, which index the data files of \p data_files.
+ * @param data_files the data files.
+ * @param original_usages the resources used by the original model with every data file.
+ */
+void sort_longest_first(std::deque<MutantJob>& jobs, std::span<const std::string> data_files, std::span<const MuMiniZinc::Entry::Usage> original_usages)
 {
-    std::string_view contents;
-    std::string_view data_file;
-    std::string& output;
-};
+    std::vector<std::size_t> order(data_files.size());
+    std::ranges::iota(order, std::size_t {});
+    std::ranges::stable_sort(order, std::ranges::greater {}, [original_usages](std::size_t index)
+        { return original_usages[index].wall_time; });
 
-struct MutantJob
-{
-    std::string_view contents;
-    std::string_view data_file;
-    std::string& original_output;
-    MuMiniZinc::Entry::Status& status;
-};
-
-template<typename Job>
-    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
-void launch_process(boost::asio::io_context& ctx, const std::filesystem::path& path, std::chrono::seconds timeout, std::queue<Job>& jobs, std::span<boost::string_view> arguments, std::uint64_t& completed_tasks, double total_tasks, logging::output logging_output)
-{
-    if (jobs.empty())
-        return;
+    std::vector<std::size_t> ranks(data_files.size());
 
-    auto job = std::move(jobs.front());
-    jobs.pop();
+    for (const auto [rank, index] : std::ranges::views::enumerate(order))
+        ranks[index] = static_cast<std::size_t>(rank);
 
-    if (!job.data_file.empty())
-        arguments.back() = boost::string_view { job.data_file.data(), job.data_file.size() };
+    std::ranges::stable_sort(jobs, std::ranges::less {}, [&ranks](const MutantJob& job)
+        { return ranks[job.data_file_index]; });
+}
 
-    boost::asio::readable_pipe out_pipe { ctx };
-    boost::asio::readable_pipe err_pipe { ctx };
-    boost::asio::writable_pipe in_pipe { ctx };
+/**
+ * Returns the name of the file with the golden output of the original model with a data file, which is
+ * the normalized path of the data file followed by `.out`, or `original.out` without data files. The
+ * separators of the path are written as `%2F` and `%3A`, and `%` as `%25`, so data files with the same
+ * name in different directories do not share their golden output.
+ */
+[[nodiscard]] std::filesystem::path get_golden_output_name(std::string_view data_file)
+{
+    if (data_file.empty())
+        return "original.out";
 
-    auto process = std::make_unique<boost::process::process>(
-        ctx,
-        path,
-        arguments,
-        boost::process::process_stdio { .in = in_pipe, .out = out_pipe, .err = err_pipe });
+    const auto path = std::filesystem::path { data_file }.lexically_normal().generic_string();
 
-    boost::system::error_code error_code;
+    std::string name;
+    name.reserve(path.size() + 4);
 
-    if (!job.contents.empty())
+    for (const auto character : path)
     {
-        boost::asio::write(in_pipe, boost::asio::buffer(job.contents), error_code);
-
-        if (error_code && !(error_code == boost::asio::error::eof))
-            throw MuMiniZinc::ExecutionError { "Cannot write the input." };
-    }
-
-    in_pipe.close();
-
-    process->async_wait([&ctx, &path, timeout, &jobs, arguments, &completed_tasks, logging_output, total_tasks, out_pipe = std::move(out_pipe), err_pipe = std::move(err_pipe), job = std::move(job), process = std::move(process)](boost::system::error_code ec, int exit_code) mutable
+        switch (character)
         {
-            ++completed_tasks;
-
-            if(logging_output.has_value())
-            {
-                logging_output.print("{:s}{:s}Progress{:s}: {:d} of {:g} execution{:s}({:0.2f}%)", logging::carriage_return(), logging::code(logging::Style::Bold), logging::code(logging::Style::Reset), completed_tasks, total_tasks, total_tasks > 1 ? "s " : " ", static_cast<double>(completed_tasks) / total_tasks * 100);
-
-                if (logging::color_support::get())
-                    logging_output.get_stream()->flush();
-                else
-                    logging_output.println();
-            }
-
-            // If an error occurred, don't do anything.
-            if (ec)
-                return;
-
-            boost::system::error_code error_code;
-
-            std::string output;
-
-            boost::asio::read(exit_code == EXIT_SUCCESS ? out_pipe : err_pipe, boost::asio::dynamic_buffer(output), error_code);
-
-            if (output.empty())
-            {
-                logging_output.println(); // Print a new line so the exception message is below the progress text.
-                throw MuMiniZinc::ExecutionError { "Cannot grab the output of the executable." };
-            }
-
-            if constexpr(std::is_same_v<Job, OriginalJob>)
-            {
-                if (exit_code != EXIT_SUCCESS)
-                {
-                    logging_output.println();
-                    throw MuMiniZinc::ExecutionError { std::format("Could not run the original model:\n{:s}", output) };
-                }
+            case '%':
+                name += "%25";
+                break;
+            case '/':
+                name += "%2F";
+                break;
+            case ':':
+                name += "%3A";
+                break;
+            default:
+                name += character;
+        }
+    }
 
-                job.output = std::move(output);
-            }
-            else
-            {
-                if (exit_code != EXIT_SUCCESS)
-                    job.status = MuMiniZinc::Entry::Status::Invalid;
-                else if (output == job.original_output)
-                    job.status = MuMiniZinc::Entry::Status::Alive;
-                else
-                    job.status = MuMiniZinc::Entry::Status::Dead;
-            }
+    name += ".out";
 
-            launch_process(ctx, path, timeout, jobs, arguments, completed_tasks, total_tasks, logging_output); });
+    return name;
 }
 
-void check_version(boost::asio::io_context& ctx, const std::filesystem::path& path)
+/**
+ * Runs the compiler with `--version`.
+ *
+ * @return the output of the compiler.
+ *
+ * @throws MuMiniZinc::BadVersion if the compiler fails or does not print anything.
+ */
+[[nodiscard]] std::string get_version(boost::asio::io_context& ctx, const std::filesystem::path& path)
 {
     boost::asio::readable_pipe out_pipe { ctx };
 
@@ -163,12 +143,26 @@ void check_version(boost::asio::io_context& ctx, const std::filesystem::path& pa
     if (process.exit_code() != EXIT_SUCCESS)
         throw MuMiniZinc::BadVersion { "Could not verify the compiler's version: The compiler exit code is not success." };
 
-    if (!output.contains(MuMiniZinc::minizinc_version_full))
+    return output;
+}
+
+void check_version(std::string_view version)
+{
+    if (!version.contains(MuMiniZinc::minizinc_version_full))
         throw MuMiniZinc::BadVersion { "Compiler version mismatch." };
 }
 
+/** Whether a mutant belongs to a shard. It only depends on the name of the mutant, so every process agrees on it. */
+[[nodiscard]] bool is_in_shard(std::string_view name, std::uint64_t shard_index, std::uint64_t shard_count) noexcept
+{
+    Hasher hasher;
+    hasher.update(name);
+
+    return hasher.digest() % shard_count == shard_index;
 }
 
+} // namespace
+
 namespace MuMiniZinc
 {
 
@@ -196,8 +190,16 @@ void execute_mutants(const MuMiniZinc::execution_args& parameters)
 
     boost::asio::io_context ctx;
 
-    if (parameters.check_compiler_version)
-        check_version(ctx, parameters.compiler_path);
+    // The in-process engine uses the same libminizinc this project has been compiled with.
+    std::string version { parameters.engine == ExecutionEngine::InProcess ? minizinc_version_full : std::string_view {} };
+
+    if ((parameters.check_compiler_version || !parameters.cache_path.empty() || !parameters.journal_path.empty()) && parameters.engine != ExecutionEngine::InProcess)
+    {
+        version = get_version(ctx, parameters.compiler_path);
+
+        if (parameters.check_compiler_version)
+            check_version(version);
+    }
 
     // Set the arguments for the executable.
     std::vector<boost::string_view> arguments;
@@ -208,6 +210,9 @@ void execute_mutants(const MuMiniZinc::execution_args& parameters)
     for (const auto argument : parameters.compiler_arguments)
         arguments.emplace_back(argument.data(), argument.size());
 
+    if (parameters.statistics)
+        arguments.emplace_back("--statistics");
+
     // Handle the user-given timeout.
     std::string time_limit;
 
@@ -224,53 +229,335 @@ void execute_mutants(const MuMiniZinc::execution_args& parameters)
 
     std::vector<std::string> original_outputs { std::max(parameters.data_files.size(), std::vector<std::string>::size_type { 1 }) };
 
+    // The resources used by the original model go to the caller, if it has asked for them.
+    std::vector<MuMiniZinc::Entry::Usage> own_original_usages;
+    auto original_usages = parameters.original_usages;
+
+    if (original_usages.size() != original_outputs.size())
+    {
+        own_original_usages.resize(original_outputs.size());
+        original_usages = own_original_usages;
+    }
+
+    // With shared files, every model is written once and given by its path with every data file, instead of being piped every time.
+    std::optional<ScratchDirectory> scratch_directory;
+    std::deque<std::string> model_paths;
+
+    // The workers may run on other machines, so they are always sent the contents of the models.
+    if (parameters.shared_files && parameters.engine == ExecutionEngine::Process && !parameters.reuse_original_solutions && parameters.worker_command.empty())
+        scratch_directory.emplace(true);
+
+    const auto share = [&](std::string_view name, std::string_view contents) -> std::pair<std::string_view, std::string_view>
+    {
+        if (!scratch_directory.has_value())
+            return { contents, std::string_view {} };
+
+        const auto path = scratch_directory->path() / name;
+        write_file(path, contents);
+
+        return { std::string_view {}, model_paths.emplace_back(logging::path_to_utf8(path)) };
+    };
+
     // First, add the jobs for the original model, so we can make sure it actually compiles and runs with all the provided data files.
-    std::queue<OriginalJob> original_jobs;
+    std::deque<OriginalJob> original_jobs;
+
+    const auto [original_contents, original_path] = share("original.mzn", parameters.normalized_model);
 
-    if (parameters.data_files.empty())
-        original_jobs.emplace(parameters.normalized_model, std::string_view {}, original_outputs.front());
+    // The staged engines need the FlatZinc or the solutions of the original model, not only its output. The in-process engine runs every model in one piece.
+    const auto is_staged = parameters.engine == ExecutionEngine::Delta || (parameters.reuse_original_solutions && parameters.engine != ExecutionEngine::InProcess);
+    const auto uses_golden_outputs = !parameters.golden_outputs_path.empty() && !is_staged;
+
+    if (uses_golden_outputs)
+    {
+        for (std::size_t index {}; index < original_outputs.size(); ++index)
+        {
+            const std::string_view data_file = parameters.data_files.empty() ? std::string_view {} : parameters.data_files[index];
+            original_outputs[index] = read_file(parameters.golden_outputs_path / get_golden_output_name(data_file));
+
+            if (parameters.statistics)
+                strip_statistics(original_outputs[index], original_usages[index].statistics);
+        }
+    }
+    else if (parameters.data_files.empty())
+        original_jobs.emplace_back(original_contents, std::string_view {}, original_outputs.front(), original_path, &original_usages.front());
     else
     {
         for (const auto [index, data_file] : std::ranges::views::enumerate(parameters.data_files))
-            original_jobs.emplace(parameters.normalized_model, data_file, original_outputs[static_cast<std::size_t>(index)]);
+            original_jobs.emplace_back(original_contents, data_file, original_outputs[static_cast<std::size_t>(index)], original_path, &original_usages[static_cast<std::size_t>(index)]);
     }
 
+    // With a cache or a journal, every execution is identified by everything its result depends on: the compiler, its arguments, the limits, the data and the models.
+    // The results of previous runs come from the cache and, when resuming, from the journal.
+    std::optional<ResultCache> cache;
+    std::optional<Journal> journal;
+    std::vector<Hasher> data_hashers;
+    bool is_original_cached { true };
+
+    struct CachedExecution
+    {
+        std::uint64_t key;
+        const MuMiniZinc::Entry::Status* status;
+        const MuMiniZinc::Entry::Usage* usage;
+    };
+
+    std::vector<CachedExecution> uncached_executions;
+
+    if (!parameters.cache_path.empty() || !parameters.journal_path.empty())
+    {
+        cache.emplace();
+
+        if (!parameters.cache_path.empty())
+            cache->load(parameters.cache_path);
+
+        if (parameters.resume)
+            cache->load(parameters.journal_path);
+
+        if (!parameters.journal_path.empty())
+            journal.emplace(parameters.journal_path, parameters.resume);
+
+        Hasher hasher;
+        hasher.update(version);
+
+        for (const auto argument : std::span { arguments }.subspan(1, arguments.size() - (parameters.data_files.empty() ? 1 : 2)))
+            hasher.update(std::string_view { argument.data(), argument.size() });
+
+        // The limits and the way the models are run decide whether an execution fails or is stopped, and so its status.
+        hasher.update(std::format("{:d} {:d} {:d} {:d} {:d}", std::to_underlying(parameters.engine), parameters.reuse_original_solutions, parameters.max_output_size, parameters.memory_limit, parameters.cpu_time_limit.count()));
+
+        for (const auto& argument : parameters.launcher)
+            hasher.update(argument);
+
+        hasher.update(parameters.normalized_model);
+
+        data_hashers.resize(original_outputs.size(), hasher);
+
+        for (const auto [index, data_file] : std::ranges::views::enumerate(parameters.data_files))
+            data_hashers[static_cast<std::size_t>(index)].update(read_file(data_file));
+
+        // The mutants are compared against the golden outputs, which may not be what the original model writes.
+        for (std::size_t index {}; index < data_hashers.size() && uses_golden_outputs; ++index)
+            data_hashers[index].update(original_outputs[index]);
+
+        static constexpr MuMiniZinc::Entry::Status original_status { MuMiniZinc::Entry::Status::Alive };
+
+        for (std::size_t index {}; index < data_hashers.size() && !uses_golden_outputs; ++index)
+        {
+            const auto key = data_hashers[index].digest();
+
+            if (const auto* record = cache->find(key); record != nullptr)
+                original_usages[index] = record->usage;
+            else
+            {
+                is_original_cached = false;
+                uncached_executions.emplace_back(key, &original_status, &original_usages[index]);
+            }
+        }
+    }
+
+    const auto get_key = [&data_hashers](std::size_t index, const MuMiniZinc::Entry& mutant)
+    {
+        auto hasher = data_hashers[index];
+        hasher.update(mutant.contents);
+
+        return hasher.digest();
+    };
+
+    auto* const journal_pointer = journal.has_value() ? &*journal : nullptr;
+
+    // The staged engines run every data file of a mutant together, so a mutant is only skipped if all of its results are cached.
+    std::vector<MuMiniZinc::Entry*> staged_mutants;
+
     // Now, add all the mutants with all the data files and compare their outputs against the original model.
-    std::queue<MutantJob> mutant_jobs;
+    std::deque<MutantJob> mutant_jobs;
 
     for (auto& mutant : parameters.entries)
     {
         if (!parameters.allowed_mutants.empty() && !std::ranges::contains(parameters.allowed_mutants, ascii_ci_string_view { mutant.name }))
             continue;
 
-        mutant.results.resize(original_outputs.size(), MuMiniZinc::Entry::Status::Alive);
+        if (parameters.shard_count > 1 && !is_in_shard(mutant.name, parameters.shard_index, parameters.shard_count))
+            continue;
+
+        // Until its execution finishes, every result is interrupted, which tells the ones that can still be invalidated.
+        mutant.results.assign(original_outputs.size(), MuMiniZinc::Entry::Status::Interrupted);
+        mutant.usages.resize(original_outputs.size());
+
+        std::vector<bool> is_cached(original_outputs.size());
+
+        if (cache.has_value())
+        {
+            for (std::size_t index {}; index < is_cached.size(); ++index)
+            {
+                const auto* record = cache->find(get_key(index, mutant));
+                is_cached[index] = record != nullptr;
+
+                if (record != nullptr)
+                {
+                    mutant.results[index] = record->status;
+                    mutant.usages[index] = record->usage;
+                }
+            }
+
+            if (is_staged && !std::ranges::all_of(is_cached, std::identity {}))
+            {
+                std::ranges::fill(is_cached, false);
+                std::ranges::fill(mutant.results, MuMiniZinc::Entry::Status::Interrupted);
+            }
+
+            for (std::size_t index {}; index < is_cached.size(); ++index)
+            {
+                if (is_cached[index])
+                    continue;
+
+                const auto key = get_key(index, mutant);
+                uncached_executions.emplace_back(key, &mutant.results[index], &mutant.usages[index]);
+
+                if (journal.has_value())
+                    journal->expect(mutant.results[index], key, mutant.name);
+            }
+        }
+
+        if (std::ranges::all_of(is_cached, std::identity {}))
+            continue;
+
+        // Their jobs are queued by the stages once the original model has run.
+        if (is_staged)
+        {
+            staged_mutants.push_back(&mutant);
+            continue;
+        }
+
+        const auto [contents, path] = share(std::format("mutant-{:d}.mzn", model_paths.size()), mutant.contents);
 
         if (parameters.data_files.empty())
-            mutant_jobs.emplace(mutant.contents, std::string_view {}, original_outputs.front(), mutant.results.front());
+            mutant_jobs.emplace_back(contents, std::string_view {}, &original_outputs.front(), &mutant.results.front(), mutant.results, path, &mutant.usages.front(), journal_pointer, 0);
         else
         {
             for (const auto [index, data_file] : std::ranges::views::enumerate(parameters.data_files))
             {
                 const auto index_value = static_cast<std::size_t>(index);
-                mutant_jobs.emplace(mutant.contents, data_file, original_outputs[index_value], mutant.results[index_value]);
+
+                if (!is_cached[index_value])
+                    mutant_jobs.emplace_back(contents, data_file, &original_outputs[index_value], &mutant.results[index_value], mutant.results, path, &mutant.usages[index_value], journal_pointer, index_value);
+            }
+        }
+    }
+
+    // SIGINT and SIGTERM stop the run, and the executions that have not finished are reported as interrupted.
+    std::atomic<bool> interrupted {};
+    auto* const interruption = parameters.handle_interrupts ? &interrupted : nullptr;
+
+    // Writes the outputs of the original model and the new results of the cache, once everything has run.
+    const auto save_results = [&]
+    {
+        // If the run has been interrupted, the outputs of the original model may be missing.
+        if (!parameters.write_golden_outputs_path.empty() && !interrupted.load())
+        {
+            std::filesystem::create_directories(parameters.write_golden_outputs_path);
+
+            for (std::size_t index {}; index < original_outputs.size(); ++index)
+            {
+                const std::string_view data_file = parameters.data_files.empty() ? std::string_view {} : parameters.data_files[index];
+                write_file(parameters.write_golden_outputs_path / get_golden_output_name(data_file), original_outputs[index]);
             }
         }
+
+        if (parameters.cache_path.empty())
+            return;
+
+        for (const auto& execution : uncached_executions)
+            cache->store(execution.key, *execution.status, *execution.usage);
+
+        cache->save(parameters.cache_path);
+    };
+
+    // Everything is cached, so there is nothing to run, unless the outputs of the original model must be written.
+    if (cache.has_value() && mutant_jobs.empty() && staged_mutants.empty() && is_original_cached && (uses_golden_outputs || parameters.write_golden_outputs_path.empty()))
+    {
+        save_results();
+        return;
     }
 
-    const double total_tasks { static_cast<double>(original_jobs.size() + mutant_jobs.size()) };
+    const auto n_jobs = parameters.n_jobs == 0 ? get_default_n_jobs(parameters.compiler_arguments) : parameters.n_jobs;
+    const auto io_threads = parameters.io_threads == 0 ? std::uint64_t { std::max(std::thread::hardware_concurrency(), 1U) } : parameters.io_threads;
+
+    // The staged engines run every mutant they keep with every data file.
+    const auto mutant_count = is_staged ? staged_mutants.size() * original_outputs.size() : mutant_jobs.size();
+
+    Progress progress { static_cast<double>(original_jobs.size() + mutant_count), parameters.output_log };
+
+    // The time the original model takes with every data file is known once it has run, which it is not with golden outputs.
+    const auto schedule_mutants = [&]
+    {
+        if (parameters.scheduling == SchedulingPolicy::LongestFirst && parameters.data_files.size() > 1 && !uses_golden_outputs)
+            sort_longest_first(mutant_jobs, parameters.data_files, original_usages);
+    };
+
+    if (parameters.engine == ExecutionEngine::InProcess)
+    {
+        // Drop the model argument (`-`) and the data file placeholder, as those are handled separately.
+        std::vector<std::string> in_process_arguments;
+        in_process_arguments.reserve(arguments.size());
+
+        for (const auto argument : std::span { arguments }.subspan(1, arguments.size() - (parameters.data_files.empty() ? 1 : 2)))
+            in_process_arguments.emplace_back(argument.data(), argument.size());
+
+        run_in_process(in_process_arguments, original_jobs, progress, parameters, n_jobs, interruption);
+        schedule_mutants();
+        run_in_process(in_process_arguments, mutant_jobs, progress, parameters, n_jobs, interruption);
+
+        save_results();
+        return;
+    }
+
+    if (!parameters.worker_command.empty() && !is_staged)
+    {
+        // Drop the model argument and the data file placeholder, as the workers add their own.
+        const auto worker_arguments = std::span { arguments }.subspan(1, arguments.size() - (parameters.data_files.empty() ? 1 : 2));
+
+        Coordinator original_coordinator { ctx, parameters, worker_arguments, original_jobs, progress };
+        original_coordinator.run(n_jobs, io_threads);
+
+        schedule_mutants();
+
+        Coordinator mutant_coordinator { ctx, parameters, worker_arguments, mutant_jobs, progress };
+        mutant_coordinator.run(n_jobs, io_threads);
+
+        save_results();
+        return;
+    }
+
+    if (is_staged)
+    {
+        StagedRunner staged_runner { parameters, original_outputs, original_usages, time_limit, progress, journal_pointer };
+
+        std::deque<StageJob> stage_jobs;
+        staged_runner.queue_originals(stage_jobs);
+
+        Scheduler original_scheduler { ctx, parameters, arguments, stage_jobs, n_jobs, progress, nullptr, interruption };
+        original_scheduler.run(io_threads);
+
+        for (auto* const mutant : staged_mutants)
+            staged_runner.queue_mutant(stage_jobs, *mutant);
+
+        Scheduler mutant_scheduler { ctx, parameters, arguments, stage_jobs, n_jobs, progress, nullptr, interruption };
+        mutant_scheduler.run(io_threads);
+
+        save_results();
+        return;
+    }
 
-    std::uint64_t completed_tasks {};
+    const auto* const job_directory = scratch_directory.has_value() ? &*scratch_directory : nullptr;
 
-    for (std::size_t i {}; (parameters.n_jobs == 0 || i < parameters.n_jobs) && !original_jobs.empty(); ++i)
-        launch_process(ctx, parameters.compiler_path, parameters.timeout, original_jobs, arguments, completed_tasks, total_tasks, parameters.output_log);
+    Scheduler original_scheduler { ctx, parameters, arguments, original_jobs, n_jobs, progress, job_directory, interruption };
+    original_scheduler.run(io_threads);
 
-    ctx.run();
+    schedule_mutants();
 
-    for (std::size_t i {}; (parameters.n_jobs == 0 || i < parameters.n_jobs) && !mutant_jobs.empty(); ++i)
-        launch_process(ctx, parameters.compiler_path, parameters.timeout, mutant_jobs, arguments, completed_tasks, total_tasks, parameters.output_log);
+    Scheduler mutant_scheduler { ctx, parameters, arguments, mutant_jobs, n_jobs, progress, job_directory, interruption };
+    mutant_scheduler.run(io_threads);
 
-    ctx.restart();
-    ctx.run();
+    save_results();
 }
 
-} // namespace MuMiniZinc
\ No newline at end of file
+} // namespace MuMiniZinc
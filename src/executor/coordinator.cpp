@@ -0,0 +1,87 @@
+#include <executor/coordinator.hpp>
+
+#include <chrono>      // std::chrono::microseconds
+#include <cstdint>     // std::int64_t, std::uint64_t
+#include <format>      // std::format
+#include <optional>    // std::nullopt, std::optional
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+namespace MuMiniZinc::detail
+{
+
+[[nodiscard]] nlohmann::json get_usage_json(const MuMiniZinc::Entry::Usage& usage)
+{
+    // The resources that have not been measured are null.
+    const auto to_json = [](const auto& value)
+    { return value.has_value() ? nlohmann::json(*value) : nlohmann::json(nullptr); };
+
+    const auto to_count = [](std::chrono::microseconds time)
+    { return time.count(); };
+
+    return nlohmann::json::object({ { "wall_time", usage.wall_time.count() },
+        { "user_time", to_json(usage.user_time.transform(to_count)) },
+        { "system_time", to_json(usage.system_time.transform(to_count)) },
+        { "max_rss", to_json(usage.max_rss) },
+        { "statistics", usage.statistics } });
+}
+
+[[nodiscard]] MuMiniZinc::Entry::Usage parse_usage_json(const nlohmann::json& json)
+{
+    const auto parse_time = [&json](std::string_view name) -> std::optional<std::chrono::microseconds>
+    {
+        const auto& value = json.at(name);
+
+        if (value.is_null())
+            return std::nullopt;
+
+        return std::chrono::microseconds { value.get<std::int64_t>() };
+    };
+
+    MuMiniZinc::Entry::Usage usage {
+        .wall_time = std::chrono::microseconds { json.at("wall_time").get<std::int64_t>() },
+        .user_time = parse_time("user_time"),
+        .system_time = parse_time("system_time"),
+        .statistics = json.at("statistics").get<std::vector<std::pair<std::string, std::string>>>()
+    };
+
+    if (const auto& max_rss = json.at("max_rss"); !max_rss.is_null())
+        usage.max_rss = max_rss.get<std::uint64_t>();
+
+    return usage;
+}
+
+[[nodiscard]] ExecutionResult parse_worker_response(std::string_view line, std::uint64_t id)
+{
+    try
+    {
+        const auto response = nlohmann::json::parse(line);
+
+        if (response.at("id").get<std::uint64_t>() != id)
+            throw MuMiniZinc::ExecutionError { "A worker has returned the result of another job." };
+
+        ExecutionResult result {
+            .success = response.at("success").get<bool>(),
+            .output = response.at("output").get<std::string>(),
+            .usage = parse_usage_json(response.at("usage")),
+            .timed_out = response.at("timed_out").get<bool>(),
+            .limit_exceeded = response.at("limit_exceeded").get<bool>()
+        };
+
+        if (const auto matches = response.find("matches"); matches != response.end() && !matches->is_null())
+            result.matches = matches->get<bool>();
+
+        if (const auto exit_code = response.find("exit_code"); exit_code != response.end() && !exit_code->is_null())
+            result.exit_code = exit_code->get<int>();
+
+        return result;
+    }
+    catch (const nlohmann::json::exception&)
+    {
+        throw MuMiniZinc::ExecutionError { std::format("A worker has returned an invalid result:\n{:s}", line) };
+    }
+}
+
+} // namespace MuMiniZinc::detail
@@ -0,0 +1,463 @@
+#ifndef EXECUTOR_COORDINATOR_HPP
+#define EXECUTOR_COORDINATOR_HPP
+
+#include <algorithm>   // std::min, std::ranges::find
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <deque>       // std::deque
+#include <exception>   // std::current_exception, std::exception_ptr, std::make_exception_ptr, std::rethrow_exception
+#include <filesystem>  // std::filesystem::path
+#include <format>      // std::format
+#include <memory>      // std::make_shared, std::make_unique, std::shared_ptr, std::unique_ptr
+#include <optional>    // std::optional
+#include <span>        // std::span
+#include <string>      // std::string, std::to_string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_same_v
+#include <utility>     // std::exchange, std::move
+#include <vector>      // std::vector
+
+#include <boost/asio/buffer.hpp>            // boost::asio::buffer, boost::asio::dynamic_buffer
+#include <boost/asio/dispatch.hpp>          // boost::asio::dispatch
+#include <boost/asio/io_context.hpp>        // boost::asio::io_context
+#include <boost/asio/post.hpp>              // boost::asio::post
+#include <boost/asio/read_until.hpp>        // boost::asio::async_read_until
+#include <boost/asio/readable_pipe.hpp>     // boost::asio::readable_pipe
+#include <boost/asio/strand.hpp>            // boost::asio::make_strand, boost::asio::strand
+#include <boost/asio/writable_pipe.hpp>     // boost::asio::writable_pipe
+#include <boost/asio/write.hpp>             // boost::asio::async_write
+#include <boost/process/v2/environment.hpp> // boost::process::environment::find_executable
+#include <boost/process/v2/process.hpp>     // boost::process::process
+#include <boost/process/v2/stdio.hpp>       // boost::process::process_stdio
+#include <boost/system/error_code.hpp>      // boost::system::error_code
+#include <boost/system/system_error.hpp>    // boost::system::system_error
+#include <boost/utility/string_view.hpp>    // boost::string_view
+
+#include <nlohmann/json.hpp> // nlohmann::json
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::ExecutionError, MuMiniZinc::execution_args
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+#include <executor/job.hpp>     // MuMiniZinc::detail::complete_job, MuMiniZinc::detail::ExecutionResult, MuMiniZinc::detail::MutantJob, MuMiniZinc::detail::OriginalJob, MuMiniZinc::detail::Progress
+#include <executor/process.hpp> // MuMiniZinc::detail::replace_all, MuMiniZinc::detail::run_handlers
+
+/**
+ * @file
+ * @brief The distribution of the executions of a run to worker processes, and the messages they exchange.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** Converts the resources used by an execution to JSON, for sending them from a worker. */
+[[nodiscard]] nlohmann::json get_usage_json(const MuMiniZinc::Entry::Usage& usage);
+
+/** Reads the resources used by an execution from the JSON written by get_usage_json. */
+[[nodiscard]] MuMiniZinc::Entry::Usage parse_usage_json(const nlohmann::json& json);
+
+/**
+ * Parses the result of a job, as returned by a worker.
+ *
+ * @throws MuMiniZinc::ExecutionError if it is not valid or it is the result of another job.
+ */
+[[nodiscard]] ExecutionResult parse_worker_response(std::string_view line, std::uint64_t id);
+
+/**
+ * Sends the jobs of a queue to worker processes (MuMiniZinc::run_worker), and records their results as if
+ * they had been run here. Every worker gets a new job as soon as it returns the result of the previous one,
+ * so the work stays balanced however long the executions take.
+ *
+ * The workers are started through the shell with MuMiniZinc::execution_args::worker_command, and a worker
+ * without jobs left is sent the end of its input, so it exits. The expected output of every data file is
+ * only sent to a worker with the first job that needs it, and later jobs refer to it by its number.
+ *
+ * Like in Scheduler, the queue, the progress and the results are only touched from a strand, while every
+ * worker has a strand of its own for its pipes and for parsing its results. An error stops the run: the
+ * queued jobs are dropped and the workers are sent the end of their input, and run throws the error
+ * once they have all exited.
+ *
+ * Losing a worker, because it cannot be started, exits or returns an invalid result, is not an error by
+ * itself, as it is usual with remote machines or batch schedulers. Its job goes back to the front of the
+ * queue for the rest, so the workers without jobs are kept until every job has finished, and the run only
+ * fails once no worker is left.
+ */
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+class Coordinator
+{
+public:
+    /**
+     * @param arguments the arguments for the compiler, without the model nor the data file.
+     */
+    Coordinator(boost::asio::io_context& ctx, const MuMiniZinc::execution_args& parameters, std::span<const boost::string_view> arguments, std::deque<Job>& jobs, Progress& progress) :
+        m_ctx { ctx }, m_parameters { parameters }, m_jobs { jobs }, m_progress { progress }, m_strand { boost::asio::make_strand(ctx) }
+    {
+        for (const auto argument : arguments)
+            m_arguments.emplace_back(std::string { argument.data(), argument.size() });
+    }
+
+    /**
+     * Starts the workers, but not more than there are jobs, and runs all the jobs on them.
+     *
+     * @param n_workers the maximum amount of workers.
+     * @param n_threads the amount of threads that handle the results, including this one.
+     *
+     * @throws MuMiniZinc::ExecutionError if no worker can be started or none is left to run a job, once every worker has exited.
+     */
+    void run(std::uint64_t n_workers, std::uint64_t n_threads)
+    {
+        boost::asio::post(m_strand, [this, n_workers]
+            { start(n_workers); });
+
+        run_handlers(m_ctx, n_threads);
+
+        if (m_error != nullptr)
+            std::rethrow_exception(m_error);
+    }
+
+private:
+    static constexpr std::string_view worker_placeholder { "{worker}" };
+
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    struct Worker
+    {
+        explicit Worker(boost::asio::io_context& ctx) :
+            strand { boost::asio::make_strand(ctx) }, in_pipe { strand }, out_pipe { strand } { }
+
+        Strand strand;
+        std::unique_ptr<boost::process::process> process;
+        boost::asio::writable_pipe in_pipe;
+        boost::asio::readable_pipe out_pipe;
+
+        /** The job the worker is running, if any. */
+        std::optional<Job> job;
+        std::uint64_t job_id {};
+        std::string request;
+        std::string response;
+        /** Which expected outputs, by their number, the worker has already been sent. */
+        std::vector<bool> has_expected_output;
+    };
+
+    boost::asio::io_context& m_ctx;
+    const MuMiniZinc::execution_args& m_parameters;
+    nlohmann::json m_arguments = nlohmann::json::array();
+    std::deque<Job>& m_jobs;
+    Progress& m_progress;
+    Strand m_strand;
+    std::uint64_t m_next_id {};
+
+    std::vector<std::shared_ptr<Worker>> m_workers;
+    /** The workers without a job, which are kept until every job has finished. */
+    std::vector<std::shared_ptr<Worker>> m_idle_workers;
+    /** How many workers are running a job. */
+    std::uint64_t m_busy_workers {};
+    /** The expected outputs sent to the workers, whose positions are their numbers. */
+    std::vector<const std::string*> m_expected_outputs;
+
+    /** The first error of the run, which is thrown by run once every worker has exited. */
+    std::exception_ptr m_error;
+
+    /** Starts the workers and sends every one of them its first job, from the strand of the coordinator. */
+    void start(std::uint64_t n_workers)
+    {
+        // Every worker takes a job from the queue as it starts, so its size is only read once.
+        const auto count = std::min<std::uint64_t>(n_workers, m_jobs.size());
+
+        std::exception_ptr launch_error;
+
+        for (std::uint64_t index {}; index < count; ++index)
+        {
+            auto worker = std::make_shared<Worker>(m_ctx);
+
+            try
+            {
+                launch(*worker, index);
+            }
+            catch (const MuMiniZinc::ExecutionError&)
+            {
+                launch_error = std::current_exception();
+                continue;
+            }
+
+            m_workers.push_back(worker);
+            send_next(worker);
+        }
+
+        // The jobs of the workers that could not be started are run by the rest.
+        if (m_workers.empty() && launch_error != nullptr)
+        {
+            m_progress.output().println();
+            fail(launch_error);
+        }
+    }
+
+    void launch(Worker& worker, std::uint64_t index)
+    {
+        std::string command { m_parameters.worker_command };
+        replace_all(command, worker_placeholder, std::to_string(index));
+
+#if defined(_WIN32)
+        const auto shell = boost::process::environment::find_executable("cmd");
+        const std::vector<std::string> shell_arguments { "/C", std::move(command) };
+#else
+        const std::filesystem::path shell { "/bin/sh" };
+        const std::vector<std::string> shell_arguments { "-c", std::move(command) };
+#endif
+
+        try
+        {
+            // The error output of the worker is inherited, so its errors are shown.
+            worker.process = std::make_unique<boost::process::process>(m_ctx, shell, shell_arguments, boost::process::process_stdio { .in = worker.in_pipe, .out = worker.out_pipe, .err = {} });
+        }
+        catch (const boost::system::system_error& error)
+        {
+            throw MuMiniZinc::ExecutionError { std::format("Cannot start a worker: {:s}", error.what()) };
+        }
+    }
+
+    /**
+     * Stops the run: the queued jobs are dropped and the workers are sent the end of their input. The
+     * workers finish the jobs they are running, whose results are not recorded.
+     */
+    void fail(std::exception_ptr error)
+    {
+        if (m_error == nullptr)
+            m_error = std::move(error);
+
+        m_jobs.clear();
+        release_idle_workers();
+
+        for (const auto& worker : m_workers)
+        {
+            if (!worker->job.has_value())
+                continue;
+
+            boost::asio::dispatch(worker->strand, [worker]
+                {
+                    boost::system::error_code error_code;
+                    worker->in_pipe.close(error_code); });
+        }
+    }
+
+    /**
+     * Handles a worker that has exited or returned an invalid result, from its strand. The worker is stopped,
+     * and its job goes back to the front of the queue, for an idle worker or the next one that finishes its job.
+     * The run fails if no worker is left to run it.
+     */
+    void lose(const std::shared_ptr<Worker>& worker, std::string message)
+    {
+        boost::asio::post(m_strand, [this, worker, message = std::move(message)]() mutable
+            {
+                --m_busy_workers;
+                discard(worker);
+
+                auto job = std::move(*worker->job);
+                worker->job.reset();
+
+                if (m_error != nullptr)
+                {
+                    release_idle_workers();
+                    return;
+                }
+
+                m_jobs.push_front(std::move(job));
+                m_progress.output().println();
+
+                if (m_idle_workers.empty() && m_busy_workers == 0)
+                {
+                    fail(std::make_exception_ptr(MuMiniZinc::ExecutionError { std::format("{:s} No worker is left to run its job.", message) }));
+                    return;
+                }
+
+                m_progress.output().println("{:s} Its job goes to another worker.", message);
+
+                if (m_idle_workers.empty())
+                    return;
+
+                auto idle_worker = std::move(m_idle_workers.back());
+                m_idle_workers.pop_back();
+
+                send_next(idle_worker); });
+    }
+
+    /** Stops a worker that has been lost, in case it is still running. */
+    static void discard(const std::shared_ptr<Worker>& worker)
+    {
+        boost::asio::dispatch(worker->strand, [worker]
+            {
+                boost::system::error_code error_code;
+                worker->in_pipe.close(error_code);
+                worker->out_pipe.close(error_code);
+                worker->process->terminate(error_code); });
+    }
+
+    /**
+     * Keeps a worker without jobs, from the strand of the coordinator, as a job of a worker that is lost would
+     * go back to the queue. Once no worker is running a job, every idle worker is released.
+     */
+    void park(const std::shared_ptr<Worker>& worker)
+    {
+        m_idle_workers.push_back(worker);
+        release_idle_workers();
+    }
+
+    /** Releases the idle workers once no worker is running a job, from the strand of the coordinator. */
+    void release_idle_workers()
+    {
+        if (m_busy_workers != 0)
+            return;
+
+        for (const auto& worker : std::exchange(m_idle_workers, {}))
+            release(worker);
+    }
+
+    /** Sends the end of the input to a worker without jobs left, and waits for it to exit. */
+    static void release(const std::shared_ptr<Worker>& worker)
+    {
+        boost::asio::dispatch(worker->strand, [worker]
+            {
+                boost::system::error_code error_code;
+                worker->in_pipe.close(error_code);
+
+                // Keep the process around until it exits.
+                worker->process->async_wait([worker](boost::system::error_code, int) { }); });
+    }
+
+    /** Returns the number of an expected output, which is the same for every job with the same data file. */
+    [[nodiscard]] std::uint64_t get_expected_output_id(const std::string& expected_output)
+    {
+        const auto found = std::ranges::find(m_expected_outputs, &expected_output);
+
+        if (found != m_expected_outputs.end())
+            return static_cast<std::uint64_t>(found - m_expected_outputs.begin());
+
+        m_expected_outputs.push_back(&expected_output);
+
+        return m_expected_outputs.size() - 1;
+    }
+
+    [[nodiscard]] nlohmann::json get_request(Worker& worker, const Job& job, std::uint64_t id)
+    {
+        auto request = nlohmann::json::object({ { "id", id },
+            { "model", std::string { job.contents } },
+            { "arguments", m_arguments },
+            { "timeout", m_parameters.timeout.count() },
+            { "max_output_size", m_parameters.max_output_size },
+            { "max_error_size", m_parameters.max_error_size },
+            { "memory_limit", m_parameters.memory_limit },
+            { "cpu_time_limit", m_parameters.cpu_time_limit.count() },
+            { "statistics", m_parameters.statistics } });
+
+        if (!job.data_file.empty())
+            request["data_file"] = std::string { job.data_file };
+
+        // The worker compares the output while it is read, so it can stop the mutant as soon as it diverges.
+        if constexpr (std::is_same_v<Job, MutantJob>)
+        {
+            const auto expected_id = get_expected_output_id(*job.original_output);
+            request["expected_id"] = expected_id;
+
+            if (worker.has_expected_output.size() <= expected_id)
+                worker.has_expected_output.resize(static_cast<std::size_t>(expected_id + 1));
+
+            if (!worker.has_expected_output[static_cast<std::size_t>(expected_id)])
+            {
+                worker.has_expected_output[static_cast<std::size_t>(expected_id)] = true;
+                request["expected"] = *job.original_output;
+            }
+        }
+
+        return request;
+    }
+
+    /** Sends the next job of the queue to a worker, from the strand of the coordinator. */
+    void send_next(const std::shared_ptr<Worker>& worker)
+    {
+        if constexpr (std::is_same_v<Job, MutantJob>)
+        {
+            // The mutant has been found invalid with another data file.
+            while (!m_jobs.empty() && *m_jobs.front().status == MuMiniZinc::Entry::Status::Invalid)
+            {
+                m_jobs.pop_front();
+                m_progress.advance();
+            }
+        }
+
+        if (m_jobs.empty())
+        {
+            park(worker);
+            return;
+        }
+
+        worker->job.emplace(std::move(m_jobs.front()));
+        m_jobs.pop_front();
+        ++m_busy_workers;
+
+        worker->job_id = m_next_id++;
+        worker->request = get_request(*worker, *worker->job, worker->job_id).dump();
+        worker->request.push_back('\n');
+
+        boost::asio::dispatch(worker->strand, [this, worker]
+            {
+                // A worker that has exited is detected when reading its result.
+                boost::asio::async_write(worker->in_pipe, boost::asio::buffer(worker->request), [worker](boost::system::error_code, std::size_t) { });
+
+                read_result(worker); });
+    }
+
+    /** Reads and parses the result of the job of a worker, from its strand. */
+    void read_result(const std::shared_ptr<Worker>& worker)
+    {
+        boost::asio::async_read_until(worker->out_pipe, boost::asio::dynamic_buffer(worker->response), '\n', [this, worker](boost::system::error_code ec, std::size_t size)
+            {
+                if (ec)
+                {
+                    lose(worker, "A worker has exited before returning the result of its job.");
+                    return;
+                }
+
+                ExecutionResult result;
+
+                try
+                {
+                    result = parse_worker_response(std::string_view { worker->response }.substr(0, size), worker->job_id);
+                }
+                catch (const MuMiniZinc::ExecutionError& error)
+                {
+                    lose(worker, error.what());
+                    return;
+                }
+
+                worker->response.erase(0, size);
+
+                boost::asio::post(m_strand, [this, worker, result = std::move(result)]() mutable
+                    { complete(worker, std::move(result)); }); });
+    }
+
+    /** Records the result of the job of a worker and sends it the next one, from the strand of the coordinator. */
+    void complete(const std::shared_ptr<Worker>& worker, ExecutionResult result)
+    {
+        --m_busy_workers;
+
+        if (m_error == nullptr)
+        {
+            m_progress.advance();
+
+            try
+            {
+                complete_job(*worker->job, std::move(result), m_progress);
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        }
+
+        worker->job.reset();
+        send_next(worker);
+    }
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
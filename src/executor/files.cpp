@@ -0,0 +1,54 @@
+#include <executor/files.hpp>
+
+#include <format>       // std::format
+#include <fstream>      // std::ifstream, std::ofstream
+#include <ios>          // std::ios
+#include <iterator>     // std::istreambuf_iterator
+#include <random>       // std::random_device
+#include <system_error> // std::error_code
+
+#include <muminizinc/build/config.hpp> // MuMiniZinc::build::executable_name
+#include <muminizinc/logging.hpp>      // logging::code, logging::Color, logging::path_to_utf8, logging::Style
+#include <muminizinc/mutation.hpp>     // MuMiniZinc::IOError
+
+namespace MuMiniZinc::detail
+{
+
+ScratchDirectory::ScratchDirectory(bool in_memory)
+{
+    const auto temporary_directory = in_memory && std::filesystem::is_directory(shared_memory_directory) ? std::filesystem::path { shared_memory_directory } : std::filesystem::temp_directory_path();
+
+    std::random_device random_device;
+
+    do
+        m_path = temporary_directory / std::format("{:s}-{:08x}", MuMiniZinc::build::executable_name, random_device());
+    while (!std::filesystem::create_directory(m_path));
+}
+
+ScratchDirectory::~ScratchDirectory()
+{
+    std::error_code error_code;
+    std::filesystem::remove_all(m_path, error_code);
+}
+
+std::string read_file(const std::filesystem::path& path)
+{
+    std::ifstream file { path, std::ios::binary };
+
+    if (!file.is_open())
+        throw MuMiniZinc::IOError { std::format("Could not open the file `{:s}{:s}{:s}`.", logging::code(logging::Color::Blue), logging::path_to_utf8(path), logging::code(logging::Style::Reset)) };
+
+    return std::string { std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {} };
+}
+
+void write_file(const std::filesystem::path& path, std::string_view contents)
+{
+    std::ofstream file { path, std::ios::binary };
+
+    file << contents;
+
+    if (file.fail())
+        throw MuMiniZinc::IOError { std::format("Could not write to the file `{:s}{:s}{:s}`.", logging::code(logging::Color::Blue), logging::path_to_utf8(path), logging::code(logging::Style::Reset)) };
+}
+
+} // namespace MuMiniZinc::detail
@@ -0,0 +1,55 @@
+#ifndef EXECUTOR_FILES_HPP
+#define EXECUTOR_FILES_HPP
+
+#include <filesystem>  // std::filesystem::path
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+/**
+ * @file
+ * @brief The files the models and the stages of the executions are written to.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** A temporary directory that is removed, along with its contents, when destroyed. */
+class ScratchDirectory
+{
+public:
+    /**
+     * Creates the directory.
+     *
+     * @param in_memory whether to create it in `/dev/shm`, if available, instead of the system's temporary directory.
+     */
+    explicit ScratchDirectory(bool in_memory = false);
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    ~ScratchDirectory();
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return m_path; }
+
+private:
+    static constexpr std::string_view shared_memory_directory { "/dev/shm" };
+
+    std::filesystem::path m_path;
+};
+
+/**
+ * Reads a whole file.
+ *
+ * @throws MuMiniZinc::IOError if the file cannot be opened.
+ */
+[[nodiscard]] std::string read_file(const std::filesystem::path& path);
+
+/**
+ * Writes a whole file, replacing its contents.
+ *
+ * @throws MuMiniZinc::IOError if the file cannot be written.
+ */
+void write_file(const std::filesystem::path& path, std::string_view contents);
+
+} // namespace MuMiniZinc::detail
+
+#endif
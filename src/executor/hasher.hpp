@@ -0,0 +1,48 @@
+#ifndef EXECUTOR_HASHER_HPP
+#define EXECUTOR_HASHER_HPP
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <string_view> // std::string_view
+
+/**
+ * @file
+ * @brief The hash that identifies the executions in the result cache and the journal, and the mutants of every shard.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** A 64-bit FNV-1a hash, fed with fields that are prefixed by their size so their boundaries are part of the hash. */
+class Hasher
+{
+public:
+    /** Feeds a field to the hash. */
+    void update(std::string_view field) noexcept
+    {
+        auto size = static_cast<std::uint64_t>(field.size());
+
+        for (std::size_t i {}; i < sizeof(size); ++i, size >>= 8U)
+            add(static_cast<unsigned char>(size & 0xFFU));
+
+        for (const auto character : field)
+            add(static_cast<unsigned char>(character));
+    }
+
+    [[nodiscard]] constexpr std::uint64_t digest() const noexcept { return m_hash; }
+
+private:
+    static constexpr std::uint64_t offset_basis { 14'695'981'039'346'656'037ULL };
+    static constexpr std::uint64_t prime { 1'099'511'628'211ULL };
+
+    std::uint64_t m_hash { offset_basis };
+
+    constexpr void add(unsigned char byte) noexcept
+    {
+        m_hash ^= byte;
+        m_hash *= prime;
+    }
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
@@ -0,0 +1,471 @@
+#include <executor/in_process.hpp>
+
+#include <algorithm>   // std::max
+#include <array>       // std::array
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::duration_cast, std::chrono::microseconds, std::chrono::seconds, std::chrono::steady_clock
+#include <csignal>     // std::raise, std::signal, SIG_DFL, SIGINT, SIGKILL, SIGTERM
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <cstdlib>     // std::_Exit, EXIT_FAILURE, EXIT_SUCCESS
+#include <deque>       // std::deque
+#include <exception>   // std::exception
+#include <format>      // std::format
+#include <memory>      // std::make_shared, std::shared_ptr
+#include <optional>    // std::optional
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_same_v
+#include <utility>     // std::move, std::pair
+#include <vector>      // std::erase, std::vector
+
+#include <boost/asio/buffer.hpp>        // boost::asio::buffer
+#include <boost/asio/io_context.hpp>    // boost::asio::io_context
+#include <boost/asio/readable_pipe.hpp> // boost::asio::readable_pipe
+#include <boost/asio/signal_set.hpp>    // boost::asio::signal_set
+#include <boost/asio/steady_timer.hpp>  // boost::asio::steady_timer
+#include <boost/system/error_code.hpp>  // boost::system::error_code
+
+#include <minizinc/exception.hh> // MiniZinc::Exception
+#include <minizinc/solver.hh>    // MiniZinc::MznSolver, MiniZinc::SolverInstance
+
+#include <muminizinc/build/config.hpp> // MuMiniZinc::build::executable_name
+#include <muminizinc/executor.hpp>     // MuMiniZinc::execution_args, MuMiniZinc::ExecutionError
+#include <muminizinc/mutation.hpp>     // MuMiniZinc::Entry
+
+#include <executor/job.hpp>     // MuMiniZinc::detail::complete_job, MuMiniZinc::detail::ExecutionResult, MuMiniZinc::detail::MutantJob, MuMiniZinc::detail::Progress, MuMiniZinc::detail::record_result, MuMiniZinc::detail::strip_statistics
+#include <executor/process.hpp> // MuMiniZinc::detail::time_limit_margin
+
+#if defined(__unix__)
+#    include <fcntl.h>        // fcntl, F_SETFD, FD_CLOEXEC
+#    include <signal.h>       // kill
+#    include <sys/resource.h> // rusage
+#    include <sys/time.h>     // timeval
+#    include <sys/types.h>    // pid_t
+#    include <sys/wait.h>     // wait4, waitpid, WEXITSTATUS, WIFEXITED, WIFSIGNALED, WTERMSIG
+#    include <unistd.h>       // close, fork, pipe, setpgid, write
+
+#    include <cerrno> // errno, EINTR
+#endif
+
+namespace
+{
+
+#if defined(__unix__)
+/** The size of the reads of the output of a helper. */
+constexpr std::size_t helper_buffer_size { 64 * 1024 };
+
+/**
+ * Flattens a model inside this process through libminizinc and runs the FlatZinc solver on the result.
+ * The solver's output is post-processed in this process too.
+ *
+ * @param model the contents of the model.
+ * @param arguments the arguments for the compiler, as they would be given to `minizinc`.
+ *
+ * @return whether the execution succeeded, and the output if it did or the error output if not.
+ */
+[[nodiscard]] std::pair<bool, std::string> flatten_and_solve(std::string_view model, const std::vector<std::string>& arguments)
+{
+    std::ostringstream output;
+    std::ostringstream error_output;
+
+    try
+    {
+        MiniZinc::MznSolver solver { output, error_output };
+
+        if (solver.run(arguments, std::string { model }, std::string { MuMiniZinc::build::executable_name }) != MiniZinc::SolverInstance::ERROR)
+            return { true, std::move(output).str() };
+    }
+    catch (const MiniZinc::Exception& exception)
+    {
+        exception.print(error_output);
+    }
+    catch (const std::exception& exception)
+    {
+        error_output << exception.what();
+    }
+
+    return { false, std::move(error_output).str() };
+}
+
+/**
+ * The body of a helper, in the forked process: runs the model and writes the output to the pipe.
+ * The helper exits without running the destructors nor the handlers at exit, which belong to its parent.
+ */
+[[noreturn]] void run_helper(int descriptor, std::string_view model, const std::vector<std::string>& arguments) noexcept
+{
+    // The parent may kill the helper before it gets here, so it sets the process group too.
+    ::setpgid(0, 0);
+
+    // The handlers of the parent would write to its signal set.
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+
+    auto success = false;
+
+    try
+    {
+        auto [succeeded, output] = flatten_and_solve(model, arguments);
+        success = succeeded;
+
+        for (std::string_view rest { output }; !rest.empty();)
+        {
+            const auto written = ::write(descriptor, rest.data(), rest.size());
+
+            if (written < 0 && errno != EINTR)
+                break;
+
+            if (written > 0)
+                rest.remove_prefix(static_cast<std::size_t>(written));
+        }
+    }
+    catch (...)
+    {
+        success = false;
+    }
+
+    std::_Exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/** Kills a helper, along with the solver it has spawned. */
+void kill_helper(::pid_t pid) noexcept
+{
+    ::kill(-pid, SIGKILL);
+}
+
+/** Runs the jobs of a queue in forked helpers, up to a maximum at the same time. */
+template<typename Job>
+class HelperPool
+{
+public:
+    HelperPool(const std::vector<std::string>& arguments, std::deque<Job>& jobs, MuMiniZinc::detail::Progress& progress, const MuMiniZinc::execution_args& parameters, std::uint64_t max_jobs, std::atomic<bool>* interrupted) :
+        m_arguments { arguments }, m_jobs { jobs }, m_progress { progress }, m_parameters { parameters }, m_max_jobs { std::max(max_jobs, std::uint64_t { 1 }) }, m_interrupted { interrupted }
+    {
+    }
+
+    HelperPool(const HelperPool&) = delete;
+    HelperPool& operator=(const HelperPool&) = delete;
+
+    /** Runs every job, and kills the helpers that are still running if something fails. */
+    void run();
+
+private:
+    /** A running helper and the job it runs. */
+    struct Helper
+    {
+        Helper(boost::asio::io_context& ctx, Job job, int descriptor, ::pid_t pid) :
+            job { std::move(job) }, pipe { ctx, descriptor }, timer { ctx }, pid { pid }, start_time { std::chrono::steady_clock::now() } { }
+
+        Job job;
+        boost::asio::readable_pipe pipe;
+        boost::asio::steady_timer timer;
+        ::pid_t pid;
+        std::chrono::steady_clock::time_point start_time;
+
+        std::array<char, helper_buffer_size> buffer {};
+        std::string output;
+
+        bool timed_out {};
+        bool interrupted {};
+        /** Whether the helper has been reaped, so its process ID may belong to another process. */
+        bool exited {};
+    };
+
+    /** Launches helpers until the maximum is reached or there are no jobs left. */
+    void fill();
+
+    /** Forks a helper for a job. */
+    void launch(Job job);
+
+    void read(std::shared_ptr<Helper> helper);
+
+    void enforce_time_limit(const std::shared_ptr<Helper>& helper);
+
+    /** Reaps a helper whose output has been closed, and completes its job. */
+    void complete(const std::shared_ptr<Helper>& helper);
+
+    /** Stops the run on SIGINT or SIGTERM. */
+    void interrupt(int signal);
+
+    /** Records the queued jobs as interrupted, without launching them. */
+    void drop_jobs();
+
+    /** Kills and reaps every running helper. */
+    void kill_all() noexcept;
+
+    boost::asio::io_context m_ctx;
+    const std::vector<std::string>& m_arguments;
+    std::deque<Job>& m_jobs;
+    MuMiniZinc::detail::Progress& m_progress;
+    const MuMiniZinc::execution_args& m_parameters;
+    std::uint64_t m_max_jobs;
+    std::atomic<bool>* m_interrupted;
+    std::optional<boost::asio::signal_set> m_signals;
+    std::vector<std::shared_ptr<Helper>> m_helpers;
+};
+
+template<typename Job>
+void HelperPool<Job>::run()
+{
+    // The signals are caught even if the run cannot be interrupted, so the helpers do not outlive this process.
+    m_signals.emplace(m_ctx, SIGINT, SIGTERM);
+    m_signals->async_wait([this](boost::system::error_code ec, int signal)
+        {
+            if (!ec)
+                interrupt(signal); });
+
+    try
+    {
+        fill();
+        m_ctx.run();
+    }
+    catch (...)
+    {
+        kill_all();
+        throw;
+    }
+
+    m_signals.reset();
+}
+
+template<typename Job>
+void HelperPool<Job>::fill()
+{
+    if (m_interrupted != nullptr && m_interrupted->load())
+        drop_jobs();
+
+    while (m_helpers.size() < m_max_jobs && !m_jobs.empty())
+    {
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        if constexpr (std::is_same_v<Job, MuMiniZinc::detail::MutantJob>)
+        {
+            // The mutant has been found invalid with another data file.
+            if (*job.status == MuMiniZinc::Entry::Status::Invalid)
+            {
+                m_progress.advance();
+                continue;
+            }
+        }
+
+        launch(std::move(job));
+    }
+
+    // Once everything has finished, stop waiting for signals, so the context runs out of work.
+    if (m_helpers.empty() && m_jobs.empty() && m_signals.has_value())
+        m_signals->cancel();
+}
+
+template<typename Job>
+void HelperPool<Job>::launch(Job job)
+{
+    auto job_arguments = m_arguments;
+
+    if (!job.data_file.empty())
+        job_arguments.emplace_back(job.data_file);
+
+    std::array<int, 2> descriptors {};
+
+    if (::pipe(descriptors.data()) != 0)
+        throw MuMiniZinc::ExecutionError { "Cannot create the pipe of a helper." };
+
+    // The solvers spawned by the helpers must not hold the pipes of the other helpers open.
+    ::fcntl(descriptors[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(descriptors[1], F_SETFD, FD_CLOEXEC);
+
+    const auto pid = ::fork();
+
+    if (pid < 0)
+    {
+        ::close(descriptors[0]);
+        ::close(descriptors[1]);
+        throw MuMiniZinc::ExecutionError { "Cannot launch a helper: The system has run out of resources." };
+    }
+
+    if (pid == 0)
+    {
+        ::close(descriptors[0]);
+        run_helper(descriptors[1], job.contents, job_arguments);
+    }
+
+    ::setpgid(pid, pid);
+    ::close(descriptors[1]);
+
+    const auto helper = std::make_shared<Helper>(m_ctx, std::move(job), descriptors[0], pid);
+    m_helpers.push_back(helper);
+
+    read(helper);
+    enforce_time_limit(helper);
+}
+
+template<typename Job>
+void HelperPool<Job>::read(std::shared_ptr<Helper> helper)
+{
+    helper->pipe.async_read_some(boost::asio::buffer(helper->buffer), [this, helper](boost::system::error_code ec, std::size_t size)
+        {
+            helper->output.append(helper->buffer.data(), size);
+
+            // The pipe is closed once the helper has exited.
+            if (ec)
+            {
+                complete(helper);
+                return;
+            }
+
+            read(helper); });
+}
+
+template<typename Job>
+void HelperPool<Job>::enforce_time_limit(const std::shared_ptr<Helper>& helper)
+{
+    if (m_parameters.timeout == std::chrono::seconds::zero())
+        return;
+
+    helper->timer.expires_after(m_parameters.timeout + MuMiniZinc::detail::time_limit_margin);
+    helper->timer.async_wait([helper](boost::system::error_code ec)
+        {
+            if (ec || helper->exited || helper->interrupted)
+                return;
+
+            helper->timed_out = true;
+            kill_helper(helper->pid); });
+}
+
+template<typename Job>
+void HelperPool<Job>::complete(const std::shared_ptr<Helper>& helper)
+{
+    int status {};
+    ::rusage usage {};
+
+    // The output is only closed when the helper exits, so this does not block for long.
+    while (::wait4(helper->pid, &status, 0, &usage) < 0)
+    {
+        if (errno != EINTR)
+            throw MuMiniZinc::ExecutionError { "Cannot wait for a helper." };
+    }
+
+    helper->exited = true;
+    helper->timer.cancel();
+    std::erase(m_helpers, helper);
+
+    const auto to_microseconds = [](const ::timeval& time)
+    { return std::chrono::seconds { time.tv_sec } + std::chrono::microseconds { time.tv_usec }; };
+
+    const auto exited = WIFEXITED(status);
+
+    MuMiniZinc::detail::ExecutionResult result {
+        .success = exited && WEXITSTATUS(status) == EXIT_SUCCESS && !helper->timed_out && !helper->interrupted,
+        .output = std::move(helper->output),
+        .usage = MuMiniZinc::Entry::Usage {
+            .wall_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - helper->start_time),
+            .user_time = to_microseconds(usage.ru_utime),
+            .system_time = to_microseconds(usage.ru_stime),
+            .max_rss = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024 // Linux reports it in kibibytes.
+        },
+        .timed_out = helper->timed_out,
+        .interrupted = helper->interrupted
+    };
+
+    if (exited)
+        result.exit_code = WEXITSTATUS(status);
+
+    if (result.interrupted)
+        result.output.clear();
+    else if (result.timed_out)
+        result.output = std::format("The execution has been stopped {:d} seconds after the time limit of {:d} seconds.", MuMiniZinc::detail::time_limit_margin.count(), m_parameters.timeout.count());
+    else if (WIFSIGNALED(status))
+        result.output = std::format("The helper has been terminated by signal {:d}.", WTERMSIG(status));
+    else if (result.success && m_parameters.statistics)
+        MuMiniZinc::detail::strip_statistics(result.output, result.usage.statistics);
+
+    m_progress.advance();
+    MuMiniZinc::detail::complete_job(helper->job, std::move(result), m_progress);
+
+    fill();
+}
+
+template<typename Job>
+void HelperPool<Job>::interrupt(int signal)
+{
+    // Without handling the interruptions, the signal stops this process once the helpers are gone.
+    if (m_interrupted == nullptr)
+    {
+        kill_all();
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+        return;
+    }
+
+    m_interrupted->store(true);
+
+    // The result of the helpers that are already being stopped is known.
+    for (const auto& helper : m_helpers)
+    {
+        if (helper->timed_out)
+            continue;
+
+        helper->interrupted = true;
+        kill_helper(helper->pid);
+    }
+
+    fill();
+}
+
+template<typename Job>
+void HelperPool<Job>::drop_jobs()
+{
+    while (!m_jobs.empty())
+    {
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        m_progress.advance();
+
+        if constexpr (std::is_same_v<Job, MuMiniZinc::detail::MutantJob>)
+        {
+            // The mutant has already been found invalid with another data file.
+            if (*job.status == MuMiniZinc::Entry::Status::Invalid)
+                continue;
+        }
+
+        MuMiniZinc::detail::record_result(job, MuMiniZinc::detail::ExecutionResult { .interrupted = true }, m_progress);
+    }
+}
+
+template<typename Job>
+void HelperPool<Job>::kill_all() noexcept
+{
+    for (const auto& helper : m_helpers)
+    {
+        kill_helper(helper->pid);
+        ::waitpid(helper->pid, nullptr, 0);
+        helper->exited = true;
+    }
+
+    m_helpers.clear();
+}
+#endif
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void run_in_process(const std::vector<std::string>& arguments, std::deque<Job>& jobs, Progress& progress, const MuMiniZinc::execution_args& parameters, std::uint64_t max_jobs, std::atomic<bool>* interrupted)
+{
+#if defined(__unix__)
+    HelperPool<Job> pool { arguments, jobs, progress, parameters, max_jobs, interrupted };
+    pool.run();
+#else
+    throw MuMiniZinc::ExecutionError { "The in-process engine is only supported on POSIX systems." };
+#endif
+}
+
+template void run_in_process(const std::vector<std::string>& arguments, std::deque<OriginalJob>& jobs, Progress& progress, const MuMiniZinc::execution_args& parameters, std::uint64_t max_jobs, std::atomic<bool>* interrupted);
+template void run_in_process(const std::vector<std::string>& arguments, std::deque<MutantJob>& jobs, Progress& progress, const MuMiniZinc::execution_args& parameters, std::uint64_t max_jobs, std::atomic<bool>* interrupted);
+
+} // namespace MuMiniZinc::detail
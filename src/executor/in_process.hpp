@@ -0,0 +1,50 @@
+#ifndef EXECUTOR_IN_PROCESS_HPP
+#define EXECUTOR_IN_PROCESS_HPP
+
+#include <atomic>      // std::atomic
+#include <cstdint>     // std::uint64_t
+#include <deque>       // std::deque
+#include <string>      // std::string
+#include <type_traits> // std::is_same_v
+#include <vector>      // std::vector
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::execution_args
+
+#include <executor/job.hpp> // MuMiniZinc::detail::MutantJob, MuMiniZinc::detail::OriginalJob, MuMiniZinc::detail::Progress
+
+/**
+ * @file
+ * @brief The executions of MuMiniZinc::ExecutionEngine::InProcess, which run libminizinc in forked helper processes.
+ */
+namespace MuMiniZinc::detail
+{
+
+/**
+ * Runs all the jobs of a queue with MuMiniZinc::ExecutionEngine::InProcess. Every job is flattened and solved
+ * by a helper forked from this process, which runs libminizinc with the model it already has in memory, and
+ * writes its output back through a pipe. libminizinc keeps global state, like its garbage collector, so every
+ * helper only flattens a single model, and up to `max_jobs` helpers run at the same time.
+ *
+ * The helpers run in their own process groups, along with the solvers they spawn, so a helper can be killed
+ * with them once it has run `time_limit_margin` past MuMiniZinc::execution_args::timeout, or once SIGINT or
+ * SIGTERM is received. With `interrupted`, the signal stops the run like in a Scheduler. Without it, the helpers
+ * are killed and the signal is raised again, so this process is stopped by it as usual.
+ *
+ * This must be called while no other thread runs, as the helpers are forked without running any executable.
+ *
+ * @param arguments the arguments for the compiler, as they would be given to `minizinc`, without the model.
+ * @param jobs the jobs, which are taken from the queue as they are launched.
+ * @param progress the progress, advanced once for every job.
+ * @param parameters the parameters of the run, from which the time limit and whether to keep the statistics are taken.
+ * @param max_jobs the amount of helpers that may run at the same time.
+ * @param interrupted the flag set by SIGINT and SIGTERM while the jobs run, shared with the other calls of a run, or `nullptr`.
+ *
+ * @throws MuMiniZinc::ExecutionError if a helper cannot be launched, or on a system that is not POSIX.
+ */
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void run_in_process(const std::vector<std::string>& arguments, std::deque<Job>& jobs, Progress& progress, const MuMiniZinc::execution_args& parameters, std::uint64_t max_jobs, std::atomic<bool>* interrupted);
+
+} // namespace MuMiniZinc::detail
+
+#endif
@@ -0,0 +1,274 @@
+#include <executor/job.hpp>
+
+#include <algorithm>    // std::min, std::ranges::any_of, std::ranges::find
+#include <array>        // std::array
+#include <cstdlib>      // EXIT_SUCCESS
+#include <filesystem>   // std::filesystem::equivalent, std::filesystem::path
+#include <format>       // std::format
+#include <optional>     // std::optional
+#include <ranges>       // std::views::split
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <system_error> // std::error_code
+#include <utility>      // std::move, std::pair
+#include <vector>       // std::vector
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::ExecutionError
+
+#include <executor/journal.hpp> // MuMiniZinc::detail::Journal
+
+namespace
+{
+
+using namespace std::string_view_literals;
+
+/**
+ * Finds the file of the first location reported by the error output of the compiler, which is
+ * printed on its own line as the file followed by its line and columns, like `model.mzn:3.12-16:`.
+ *
+ * @return the file, or `std::nullopt` if no location is reported.
+ */
+[[nodiscard]] std::optional<std::string_view> find_error_file(std::string_view error_output)
+{
+    for (const auto range : std::views::split(error_output, '\n'))
+    {
+        std::string_view line { range };
+
+        line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        line.remove_suffix(line.size() - std::min(line.find_last_not_of(" \t\r:") + 1, line.size()));
+
+        const auto separator = line.rfind(':');
+
+        if (separator == std::string_view::npos || separator == 0 || separator + 1 == line.size())
+            continue;
+
+        const auto location = line.substr(separator + 1);
+
+        if (location.find_first_of("0123456789") == 0 && location.find_first_not_of("0123456789.-") == std::string_view::npos)
+            return line.substr(0, separator);
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * Checks whether a failed execution has failed because of the model itself rather than its instance, so
+ * the model would fail with any data file. The compiler must have exited by itself with an error code,
+ * instead of being stopped, killed or running out of its limits, and the error must come from the stages
+ * that only check the model, parsing and type checking, at a location that is not the data file.
+ *
+ * @param result the result of the execution, whose output is the error output of the compiler.
+ * @param data_file the data file the model has been run with, which may be empty.
+ */
+[[nodiscard]] bool is_model_error(const MuMiniZinc::detail::ExecutionResult& result, std::string_view data_file)
+{
+    if (result.success || result.timed_out || result.limit_exceeded || result.interrupted || !result.exit_code.has_value() || *result.exit_code == EXIT_SUCCESS)
+        return false;
+
+    // The kinds of the errors the parser and the type checker report, before anything is flattened with the data.
+    static constexpr std::array model_stage_errors { "syntax error"sv, "type error"sv };
+
+    const std::string_view error_output { result.output };
+
+    const auto is_model_stage = std::ranges::any_of(model_stage_errors, [error_output](std::string_view error)
+        { return error_output.contains(error); });
+
+    if (!is_model_stage)
+        return false;
+
+    const auto error_file = find_error_file(error_output);
+
+    if (!error_file.has_value())
+        return false;
+
+    if (data_file.empty())
+        return true;
+
+    // The compiler may report the data file with another path than the one it has been given.
+    const std::filesystem::path error_path { *error_file };
+    const std::filesystem::path data_path { data_file };
+
+    std::error_code error_code;
+    const auto is_data_file = std::filesystem::equivalent(error_path, data_path, error_code);
+
+    return !is_data_file && error_path.lexically_normal() != data_path.lexically_normal();
+}
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+[[nodiscard]] bool is_timeout_output(std::string_view output)
+{
+    // An unknown status is not enough, as incomplete solvers and searches that end early also report it.
+    return output.contains("% Time limit exceeded"sv);
+}
+
+[[nodiscard]] bool is_out_of_memory_output(std::string_view error_output)
+{
+    static constexpr std::array out_of_memory_markers { "bad_alloc"sv, "out of memory"sv, "Out of memory"sv, "Cannot allocate memory"sv };
+
+    return std::ranges::any_of(out_of_memory_markers, [error_output](std::string_view marker)
+        { return error_output.contains(marker); });
+}
+
+void parse_statistics_line(std::string_view line, std::vector<std::pair<std::string, std::string>>& statistics)
+{
+    line.remove_prefix(statistics_prefix.size());
+
+    if (!line.starts_with(':'))
+        return;
+
+    line.remove_prefix(1);
+
+    const auto separator = line.find('=');
+
+    if (separator == std::string_view::npos)
+        return;
+
+    const auto trim = [](std::string_view text)
+    {
+        const auto begin = text.find_first_not_of(" \t\r\n");
+
+        if (begin == std::string_view::npos)
+            return std::string_view {};
+
+        return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+    };
+
+    const auto name = trim(line.substr(0, separator));
+    const auto value = trim(line.substr(separator + 1));
+
+    if (name.empty())
+        return;
+
+    if (const auto found = std::ranges::find(statistics, name, [](const auto& statistic) -> std::string_view
+            { return statistic.first; });
+        found != statistics.end())
+        found->second = value;
+    else
+        statistics.emplace_back(name, value);
+}
+
+void strip_statistics(std::string& output, std::vector<std::pair<std::string, std::string>>& statistics)
+{
+    std::string stripped;
+    stripped.reserve(output.size());
+
+    for (std::string_view rest { output }; !rest.empty();)
+    {
+        const auto end = rest.find('\n');
+        const auto line = rest.substr(0, end == std::string_view::npos ? rest.size() : end + 1);
+        rest.remove_prefix(line.size());
+
+        if (line.starts_with(statistics_prefix))
+            parse_statistics_line(line, statistics);
+        else
+            stripped.append(line);
+    }
+
+    output = std::move(stripped);
+}
+
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void record_result(Job& job, ExecutionResult result, Progress& progress)
+{
+    // The original model has no status, and the mutants that depend on it will not run.
+    if constexpr (std::is_same_v<Job, OriginalJob>)
+    {
+        if (result.interrupted)
+            return;
+    }
+
+    if (result.output.empty() && !result.matches.has_value() && !result.interrupted)
+    {
+        progress.output().println(); // Print a new line so the exception message is below the progress text.
+        throw MuMiniZinc::ExecutionError { "Cannot grab the output of the executable." };
+    }
+
+    if constexpr (std::is_same_v<Job, OriginalJob>)
+    {
+        if (!result.success)
+        {
+            progress.output().println();
+            throw MuMiniZinc::ExecutionError { std::format("Could not run the original model:\n{:s}", result.output) };
+        }
+
+        job.output = std::move(result.output);
+
+        if (job.usage != nullptr)
+            *job.usage = result.usage;
+    }
+    else
+    {
+        if (job.usage != nullptr)
+            *job.usage = result.usage;
+
+        if (result.interrupted)
+            *job.status = MuMiniZinc::Entry::Status::Interrupted;
+        else if (result.timed_out)
+            *job.status = MuMiniZinc::Entry::Status::Timeout;
+        else if (result.limit_exceeded)
+            *job.status = MuMiniZinc::Entry::Status::LimitExceeded;
+        else if (!result.success)
+            *job.status = MuMiniZinc::Entry::Status::Invalid;
+        else if (result.matches.value_or(result.output == *job.original_output))
+            *job.status = MuMiniZinc::Entry::Status::Alive;
+        else if (!result.matches.has_value() && is_timeout_output(result.output))
+            *job.status = MuMiniZinc::Entry::Status::Timeout;
+        else
+            *job.status = MuMiniZinc::Entry::Status::Dead;
+
+        if (job.journal != nullptr)
+            job.journal->record(*job.status, result.usage);
+    }
+}
+
+template void record_result(OriginalJob& job, ExecutionResult result, Progress& progress);
+template void record_result(MutantJob& job, ExecutionResult result, Progress& progress);
+
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void complete_job(Job& job, ExecutionResult result, Progress& progress)
+{
+    if constexpr (std::is_same_v<Job, MutantJob>)
+    {
+        // The mutant has been found invalid with another data file while this execution was running.
+        if (*job.status == MuMiniZinc::Entry::Status::Invalid)
+        {
+            if (job.usage != nullptr)
+                *job.usage = result.usage;
+
+            return;
+        }
+
+        const auto invalidates_mutant = is_model_error(result, job.data_file);
+
+        record_result(job, std::move(result), progress);
+
+        if (!invalidates_mutant)
+            return;
+
+        // The jobs of the mutant that have not finished are dropped when they are about to be launched, or ignored
+        // once they finish, so they are journaled now. The results that have already been recorded are kept.
+        for (auto& status : job.results)
+        {
+            if (status != MuMiniZinc::Entry::Status::Interrupted)
+                continue;
+
+            status = MuMiniZinc::Entry::Status::Invalid;
+
+            if (job.journal != nullptr)
+                job.journal->record(status, MuMiniZinc::Entry::Usage {});
+        }
+    }
+    else
+        record_result(job, std::move(result), progress);
+}
+
+template void complete_job(OriginalJob& job, ExecutionResult result, Progress& progress);
+template void complete_job(MutantJob& job, ExecutionResult result, Progress& progress);
+
+} // namespace MuMiniZinc::detail
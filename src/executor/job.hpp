@@ -0,0 +1,191 @@
+#ifndef EXECUTOR_JOB_HPP
+#define EXECUTOR_JOB_HPP
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <functional>  // std::function
+#include <optional>    // std::optional
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_same_v
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+#include <muminizinc/logging.hpp>  // logging::carriage_return, logging::code, logging::color_support::get, logging::output, logging::Style
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+/**
+ * @file
+ * @brief The jobs of a run of the mutants, and the classification of the results of their executions.
+ */
+namespace MuMiniZinc::detail
+{
+
+class Journal;
+
+/** An execution of the original model with a data file, whose output is captured. */
+struct OriginalJob
+{
+    std::string_view contents;
+    std::string_view data_file;
+    std::string& output;
+    /** The path of a file with the model, given instead of piping the contents if not empty. */
+    std::string_view model_path {};
+    /** Where to store the resources used by the execution, if not `nullptr`. */
+    MuMiniZinc::Entry::Usage* usage {};
+};
+
+/** An execution of a mutant with a data file, whose output is compared with the output of the original model. */
+struct MutantJob
+{
+    std::string_view contents;
+    std::string_view data_file;
+    const std::string* original_output;
+    MuMiniZinc::Entry::Status* status;
+    /** The results of the mutant with every data file, all of them marked as invalid if the mutant itself is invalid. */
+    std::span<MuMiniZinc::Entry::Status> results {};
+    /** The path of a file with the mutant, given instead of piping the contents if not empty. */
+    std::string_view model_path {};
+    /** Where to store the resources used by the execution, if not `nullptr`. */
+    MuMiniZinc::Entry::Usage* usage {};
+    /** Where to record the execution once it finishes, if not `nullptr`. */
+    Journal* journal {};
+    /** The index of the data file among the ones of the run, or 0 without data files. */
+    std::size_t data_file_index {};
+};
+
+/** The result of an execution. */
+struct ExecutionResult
+{
+    /** Whether the execution finished successfully. An execution stopped because its output diverged is successful. */
+    bool success {};
+
+    /** The standard output if it has been captured, or the error output if the execution did not succeed. */
+    std::string output;
+
+    /** If the standard output has been compared while it was being read, whether it matches the expected output. */
+    std::optional<bool> matches;
+
+    /** The resources used by the execution. */
+    MuMiniZinc::Entry::Usage usage {};
+
+    /** Whether the output has diverged because of the time limit, or the execution has been stopped for exceeding it. */
+    bool timed_out {};
+
+    /** Whether the execution has failed because of its memory or CPU time limit, or has been stopped for writing too much output. */
+    bool limit_exceeded {};
+
+    /** Whether the execution has been stopped, or not launched, because the run has been interrupted. */
+    bool interrupted {};
+
+    /** The exit code of the process, if it has exited by itself instead of being stopped or killed by a signal. */
+    std::optional<int> exit_code {};
+};
+
+/** An execution with its own arguments, whose result is handled by a callback that may queue more executions. */
+struct StageJob
+{
+    std::vector<std::string> arguments;
+    std::string_view contents;
+    std::function<void(ExecutionResult result)> on_complete;
+    /** The output the execution's output is compared with while it is read, or `nullptr` if its output is captured. */
+    const std::string* expected_output {};
+    /**
+     * The status of the execution of a mutant this job is a stage of, if any. Once the mutant is found invalid
+     * with another data file, the job is not launched, and it is completed with an unsuccessful result instead.
+     */
+    const MuMiniZinc::Entry::Status* status {};
+};
+
+/** The jobs that can be run by a Scheduler. */
+template<typename Job>
+concept ExecutionJob = std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob> || std::is_same_v<Job, StageJob>;
+
+/** The progress of a run, printed every time an execution finishes. */
+class Progress
+{
+public:
+    constexpr Progress(double total_tasks, logging::output logging_output) noexcept :
+        m_total_tasks { total_tasks }, m_logging_output { logging_output } { }
+
+    void advance()
+    {
+        ++m_completed_tasks;
+
+        if (!m_logging_output.has_value())
+            return;
+
+        m_logging_output.print("{:s}{:s}Progress{:s}: {:d} of {:g} execution{:s}({:0.2f}%)", logging::carriage_return(), logging::code(logging::Style::Bold), logging::code(logging::Style::Reset), m_completed_tasks, m_total_tasks, m_total_tasks > 1 ? "s " : " ", static_cast<double>(m_completed_tasks) / m_total_tasks * 100);
+
+        if (logging::color_support::get())
+            m_logging_output.get_stream()->flush();
+        else
+            m_logging_output.println();
+    }
+
+    [[nodiscard]] constexpr logging::output& output() noexcept { return m_logging_output; }
+
+private:
+    std::uint64_t m_completed_tasks {};
+    double m_total_tasks;
+    logging::output m_logging_output;
+};
+
+/**
+ * Checks whether an output has been printed because the time limit has been reached, which MiniZinc
+ * reports with a comment.
+ */
+[[nodiscard]] bool is_timeout_output(std::string_view output);
+
+/** How `SIGXCPU` is described when a process reports that another one has been terminated by it. */
+constexpr std::string_view cpu_time_limit_report { "CPU time limit exceeded" };
+
+/** Checks whether the error output of a failed execution reports that it could not allocate memory. */
+[[nodiscard]] bool is_out_of_memory_output(std::string_view error_output);
+
+/** The prefix of the lines with the statistics printed by the compiler and the solvers. */
+constexpr std::string_view statistics_prefix { "%%%mzn-stat" };
+
+/**
+ * Parses a statistics line, like `%%%mzn-stat: nodes=42`, and stores its value. Lines without a value,
+ * like `%%%mzn-stat-end`, are ignored.
+ */
+void parse_statistics_line(std::string_view line, std::vector<std::pair<std::string, std::string>>& statistics);
+
+/**
+ * Removes the statistics lines from a whole output, storing their values.
+ *
+ * @param output the output, which is replaced by the output without the statistics.
+ * @param statistics where to store the statistics.
+ */
+void strip_statistics(std::string& output, std::vector<std::pair<std::string, std::string>>& statistics);
+
+/**
+ * Stores the result of an execution into its job.
+ *
+ * @param job the job that has been executed.
+ * @param result the result of the execution.
+ * @param progress the progress of the execution, whose output is used for printing a new line before throwing.
+ *
+ * @throws MuMiniZinc::ExecutionError if there is no output or if the original model could not be run.
+ */
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void record_result(Job& job, ExecutionResult result, Progress& progress);
+
+/**
+ * Stores the result of an execution into its job, like record_result. If a mutant has failed because of
+ * the model itself, it would fail with any data file, so the results of the executions that have not
+ * finished yet, which are still MuMiniZinc::Entry::Status::Interrupted, are marked as invalid.
+ *
+ * A failure comes from the model if the compiler has exited by itself with an error of the stages that
+ * only read the model, parsing and type checking, whose location is not the data file.
+ */
+template<typename Job>
+    requires std::is_same_v<Job, OriginalJob> || std::is_same_v<Job, MutantJob>
+void complete_job(Job& job, ExecutionResult result, Progress& progress);
+
+} // namespace MuMiniZinc::detail
+
+#endif
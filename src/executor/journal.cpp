@@ -0,0 +1,63 @@
+#include <executor/journal.hpp>
+
+#include <chrono>   // std::chrono::microseconds
+#include <format>   // std::format, std::format_to
+#include <ios>      // std::ios
+#include <iterator> // std::back_inserter
+#include <ostream>  // std::endl, std::flush
+#include <string>   // std::string
+#include <utility>  // std::pair, std::to_underlying
+
+#include <muminizinc/logging.hpp>  // logging::code, logging::Color, logging::path_to_utf8, logging::Style
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry, MuMiniZinc::IOError
+
+namespace MuMiniZinc::detail
+{
+
+void append_record(std::string& output, std::uint64_t key, MuMiniZinc::Entry::Status status, const MuMiniZinc::Entry::Usage& usage)
+{
+    // The resources that have not been measured are written as `-`.
+    const auto to_field = [](const auto& value)
+    { return value.has_value() ? std::format("{:d}", *value) : std::string { "-" }; };
+
+    const auto to_count = [](std::chrono::microseconds time)
+    { return time.count(); };
+
+    std::format_to(std::back_inserter(output), "{:016x} {:d} {:d} {:s} {:s} {:s}", key, std::to_underlying(status), usage.wall_time.count(), to_field(usage.user_time.transform(to_count)), to_field(usage.system_time.transform(to_count)), to_field(usage.max_rss));
+}
+
+Journal::Journal(const std::filesystem::path& path, bool append)
+{
+    const auto is_new = !append || !std::filesystem::exists(path);
+
+    m_file.open(path, is_new ? std::ios::out | std::ios::trunc : std::ios::out | std::ios::app);
+
+    if (!m_file.is_open())
+        throw MuMiniZinc::IOError { std::format("Could not open the file `{:s}{:s}{:s}`.", logging::code(logging::Color::Blue), logging::path_to_utf8(path), logging::code(logging::Style::Reset)) };
+
+    if (is_new)
+        m_file << record_file_header << std::endl;
+}
+
+void Journal::expect(const MuMiniZinc::Entry::Status& status, std::uint64_t key, std::string_view name)
+{
+    m_executions.insert_or_assign(&status, std::pair { key, name });
+}
+
+void Journal::record(const MuMiniZinc::Entry::Status& status, const MuMiniZinc::Entry::Usage& usage)
+{
+    const auto found = m_executions.find(&status);
+
+    if (found == m_executions.end() || status == MuMiniZinc::Entry::Status::Interrupted)
+        return;
+
+    const auto [key, name] = found->second;
+
+    m_line.clear();
+    append_record(m_line, key, status, usage);
+    std::format_to(std::back_inserter(m_line), " {:s}\n", name);
+
+    m_file << m_line << std::flush;
+}
+
+} // namespace MuMiniZinc::detail
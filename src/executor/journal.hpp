@@ -0,0 +1,61 @@
+#ifndef EXECUTOR_JOURNAL_HPP
+#define EXECUTOR_JOURNAL_HPP
+
+#include <cstdint>       // std::uint64_t
+#include <filesystem>    // std::filesystem::path
+#include <fstream>       // std::ofstream
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <utility>       // std::pair
+
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+/**
+ * @file
+ * @brief The records of the executions, written as they finish so an interrupted run can be resumed.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** The first line of the files with records of executions, which are the result cache and the journal. */
+constexpr std::string_view record_file_header { "muminizinc-result-cache 1" };
+
+/**
+ * Appends a record of an execution, without a new line: its key, its status and the resources it used,
+ * with `-` for the ones that have not been measured.
+ */
+void append_record(std::string& output, std::uint64_t key, MuMiniZinc::Entry::Status status, const MuMiniZinc::Entry::Usage& usage);
+
+/**
+ * An append-only file with a record of every execution of a mutant that finishes, written as soon as it
+ * does, so an interrupted run can be resumed. The name of the mutant follows every record.
+ */
+class Journal
+{
+public:
+    /**
+     * Opens the journal.
+     *
+     * @param path the path of the file.
+     * @param append whether to keep the records of the file, or to start a new journal.
+     *
+     * @throws MuMiniZinc::IOError if the file cannot be opened.
+     */
+    Journal(const std::filesystem::path& path, bool append);
+
+    /** Registers the key and the name of the mutant of an execution, identified by where its status is stored. */
+    void expect(const MuMiniZinc::Entry::Status& status, std::uint64_t key, std::string_view name);
+
+    /** Writes the record of a finished execution, unless it has been interrupted. */
+    void record(const MuMiniZinc::Entry::Status& status, const MuMiniZinc::Entry::Usage& usage);
+
+private:
+    std::ofstream m_file;
+    std::unordered_map<const MuMiniZinc::Entry::Status*, std::pair<std::uint64_t, std::string_view>> m_executions;
+    std::string m_line;
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
@@ -0,0 +1,361 @@
+#include <executor/process.hpp>
+
+#include <algorithm>    // std::max, std::min, std::ranges::sort
+#include <charconv>     // std::from_chars
+#include <compare>      // std::strong_ordering
+#include <exception>    // std::current_exception, std::exception_ptr, std::rethrow_exception
+#include <filesystem>   // std::filesystem::path
+#include <format>       // std::format
+#include <fstream>      // std::ifstream
+#include <mutex>        // std::mutex, std::scoped_lock
+#include <ranges>       // std::ranges::to, std::views::enumerate, std::views::split, std::views::transform
+#include <string>       // std::getline, std::string
+#include <system_error> // std::errc
+#include <thread>       // std::jthread, std::thread::hardware_concurrency
+#include <utility>      // std::exchange
+
+#include <boost/system/errc.hpp> // boost::system::errc
+
+namespace
+{
+
+using namespace std::string_view_literals;
+
+/** A CPU, in the order they are given to the job slots. */
+struct Cpu
+{
+    /** The NUMA node of the CPU. */
+    std::uint64_t node {};
+
+    /** The position of the CPU among the hardware threads of its core, so the first thread of every core comes first. */
+    std::uint64_t sibling_rank {};
+
+    std::uint64_t id {};
+
+    auto operator<=>(const Cpu&) const = default;
+};
+
+#if defined(__linux__)
+/**
+ * Reads a list of CPUs from sysfs, like `0-3,8-11`.
+ *
+ * @return the CPUs, or an empty list if the file cannot be read.
+ */
+[[nodiscard]] std::vector<std::uint64_t> read_cpu_list(const std::filesystem::path& path)
+{
+    std::ifstream file { path };
+    std::string list;
+
+    if (!std::getline(file, list))
+        return {};
+
+    std::vector<std::uint64_t> cpus;
+
+    for (const auto range : std::views::split(std::string_view { list }, ','))
+    {
+        const std::string_view text { range };
+        const auto separator = text.find('-');
+        const auto first_text = text.substr(0, separator);
+        const auto last_text = separator == std::string_view::npos ? first_text : text.substr(separator + 1);
+
+        std::uint64_t first {};
+        std::uint64_t last {};
+
+        if (std::from_chars(first_text.data(), first_text.data() + first_text.size(), first).ec != std::errc {} || std::from_chars(last_text.data(), last_text.data() + last_text.size(), last).ec != std::errc {})
+            return {};
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+/** Finds the CPUs this process can run on, with their NUMA nodes and hardware threads when sysfs has them. */
+[[nodiscard]] std::vector<Cpu> get_cpus()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return {};
+
+    std::vector<std::uint64_t> nodes(CPU_SETSIZE);
+    std::error_code error_code;
+
+    for (const auto& entry : std::filesystem::directory_iterator { "/sys/devices/system/node", error_code })
+    {
+        const auto name = entry.path().filename().string();
+        std::uint64_t node {};
+
+        if (!name.starts_with("node") || std::from_chars(name.data() + 4, name.data() + name.size(), node).ptr != name.data() + name.size())
+            continue;
+
+        for (const auto cpu : read_cpu_list(entry.path() / "cpulist"))
+        {
+            if (cpu < nodes.size())
+                nodes[cpu] = node;
+        }
+    }
+
+    std::vector<Cpu> cpus;
+
+    for (std::uint64_t id {}; id < CPU_SETSIZE; ++id)
+    {
+        if (!CPU_ISSET(id, &allowed))
+            continue;
+
+        const auto siblings = read_cpu_list(std::format("/sys/devices/system/cpu/cpu{:d}/topology/thread_siblings_list", id));
+        const auto sibling = std::ranges::find(siblings, id);
+
+        cpus.push_back({ .node = nodes[id], .sibling_rank = sibling == siblings.end() ? 0 : static_cast<std::uint64_t>(sibling - siblings.begin()), .id = id });
+    }
+
+    return cpus;
+}
+#else
+/** Lists the CPUs of the machine, without their topology. */
+[[nodiscard]] std::vector<Cpu> get_cpus()
+{
+    std::vector<Cpu> cpus(std::max(std::thread::hardware_concurrency(), 1U));
+
+    for (auto&& [id, cpu] : std::views::enumerate(cpus))
+        cpu.id = static_cast<std::uint64_t>(id);
+
+    return cpus;
+}
+#endif
+
+/**
+ * Gives every job slot a set of CPUs, \p cpus_per_slot of them, from the CPUs this process can run on.
+ *
+ * The CPUs of a slot belong to the same NUMA node when the nodes are big enough, and the slots go round
+ * the nodes, so the executions spread over their memory. The first thread of every core is given before
+ * its siblings, so every slot has cores of its own while there are enough. If there are more slots than
+ * sets of CPUs, the sets are shared.
+ *
+ * @return the CPUs of every slot, or an empty list if the CPUs cannot be found.
+ */
+[[nodiscard]] std::vector<std::vector<std::uint64_t>> get_slot_cpus(std::uint64_t n_slots, std::uint64_t cpus_per_slot)
+{
+    auto cpus = get_cpus();
+
+    if (cpus.empty())
+        return {};
+
+    std::ranges::sort(cpus);
+
+    const auto get_ids = [](std::span<const Cpu> set)
+    { return set | std::views::transform(&Cpu::id) | std::ranges::to<std::vector>(); };
+
+    // The sets of every node, in the order they are given.
+    std::vector<std::vector<std::vector<std::uint64_t>>> node_sets;
+
+    for (std::span<const Cpu> remaining { cpus }; !remaining.empty();)
+    {
+        const auto node_end = std::ranges::find_if(remaining, [node = remaining.front().node](const Cpu& cpu)
+            { return cpu.node != node; });
+        const auto node_size = static_cast<std::size_t>(node_end - remaining.begin());
+        auto& sets = node_sets.emplace_back();
+
+        for (std::size_t first {}; first + cpus_per_slot <= node_size; first += cpus_per_slot)
+            sets.push_back(get_ids(remaining.subspan(first, cpus_per_slot)));
+
+        remaining = remaining.subspan(node_size);
+    }
+
+    // No node is big enough for a slot, so the sets are taken from the whole machine, or are the whole machine.
+    if (std::ranges::all_of(node_sets, [](const auto& sets)
+            { return sets.empty(); }))
+    {
+        std::ranges::sort(cpus, {}, [](const Cpu& cpu)
+            { return std::pair { cpu.sibling_rank, cpu.id }; });
+
+        node_sets.assign(1, {});
+
+        for (std::size_t first {}; first + cpus_per_slot <= cpus.size(); first += cpus_per_slot)
+            node_sets.front().push_back(get_ids(std::span<const Cpu> { cpus }.subspan(first, cpus_per_slot)));
+
+        if (node_sets.front().empty())
+            node_sets.front().push_back(get_ids(cpus));
+    }
+
+    // Go round the nodes.
+    std::vector<std::vector<std::uint64_t>> sets;
+
+    for (std::size_t index {};; ++index)
+    {
+        const auto given_sets = sets.size();
+
+        for (const auto& node : node_sets)
+        {
+            if (index < node.size())
+                sets.push_back(node[index]);
+        }
+
+        if (sets.size() == given_sets)
+            break;
+    }
+
+    std::vector<std::vector<std::uint64_t>> slot_cpus;
+    slot_cpus.reserve(n_slots);
+
+    for (std::uint64_t slot {}; slot < n_slots; ++slot)
+        slot_cpus.push_back(sets[slot % sets.size()]);
+
+    return slot_cpus;
+}
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+[[nodiscard]] bool is_resource_exhausted(const boost::system::error_code& error_code) noexcept
+{
+    return error_code == boost::system::errc::too_many_files_open
+        || error_code == boost::system::errc::too_many_files_open_in_system
+        || error_code == boost::system::errc::resource_unavailable_try_again;
+}
+
+void replace_all(std::string& text, std::string_view placeholder, std::string_view value)
+{
+    for (auto position = text.find(placeholder); position != std::string::npos; position = text.find(placeholder, position + value.size()))
+        text.replace(position, placeholder.size(), value);
+}
+
+[[nodiscard]] std::uint64_t get_solver_threads(std::span<const std::string_view> compiler_arguments) noexcept
+{
+    std::uint64_t threads { 1 };
+
+    for (std::size_t i {}; i < compiler_arguments.size(); ++i)
+    {
+        const auto argument = compiler_arguments[i];
+        std::string_view value;
+
+        if ((argument == "-p"sv || argument == "--parallel"sv) && i + 1 < compiler_arguments.size())
+            value = compiler_arguments[++i];
+        else if (argument.starts_with("--parallel="sv))
+            value = argument.substr("--parallel="sv.size());
+        else
+            continue;
+
+        std::uint64_t parsed {};
+        const auto [_, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+
+        if (ec == std::errc {} && parsed > 0)
+            threads = parsed;
+    }
+
+    return threads;
+}
+
+void set_solver_threads(std::vector<boost::string_view>& arguments, boost::string_view threads)
+{
+    std::erase_if(arguments, [is_value = false](boost::string_view argument) mutable
+        {
+            if (std::exchange(is_value, false))
+                return true;
+
+            is_value = argument == "-p" || argument == "--parallel";
+
+            return is_value || argument.starts_with("--parallel="); });
+
+    arguments.emplace_back("-p");
+    arguments.emplace_back(threads);
+}
+
+[[nodiscard]] std::uint64_t get_default_n_jobs(std::span<const std::string_view> compiler_arguments) noexcept
+{
+    const std::uint64_t hardware_threads { std::max(std::thread::hardware_concurrency(), 1U) };
+
+    return std::max(hardware_threads / get_solver_threads(compiler_arguments), std::uint64_t { 1 });
+}
+
+JobSlots::JobSlots(std::uint64_t n_slots, std::uint64_t cpus_per_slot, bool with_cpus) :
+    m_busy(n_slots)
+{
+    if (with_cpus)
+        m_cpus = get_slot_cpus(n_slots, cpus_per_slot);
+}
+
+std::vector<std::uint64_t> JobSlots::take(std::uint64_t count)
+{
+    std::vector<std::uint64_t> slots;
+
+    for (std::uint64_t index {}; index < m_busy.size() && slots.size() < count; ++index)
+    {
+        if (m_busy[index])
+            continue;
+
+        m_busy[index] = true;
+        slots.push_back(index);
+    }
+
+    return slots;
+}
+
+void JobSlots::release(std::span<const std::uint64_t> slots) noexcept
+{
+    for (const auto slot : slots)
+        m_busy[slot] = false;
+}
+
+std::vector<std::uint64_t> JobSlots::get_cpus(std::span<const std::uint64_t> slots) const
+{
+    std::vector<std::uint64_t> cpus;
+
+    if (m_cpus.empty())
+        return cpus;
+
+    for (const auto slot : slots)
+        cpus.insert(cpus.end(), m_cpus[slot].begin(), m_cpus[slot].end());
+
+    return cpus;
+}
+
+void run_handlers(boost::asio::io_context& ctx, std::uint64_t n_threads)
+{
+    ctx.restart();
+
+    if (n_threads <= 1)
+    {
+        ctx.run();
+        return;
+    }
+
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+
+    const auto run = [&]
+    {
+        try
+        {
+            ctx.run();
+        }
+        catch (...)
+        {
+            const std::scoped_lock lock { exception_mutex };
+
+            if (exception == nullptr)
+                exception = std::current_exception();
+
+            ctx.stop();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(static_cast<std::size_t>(n_threads - 1));
+
+        for (std::uint64_t i { 1 }; i < n_threads; ++i)
+            threads.emplace_back(run);
+
+        run();
+    }
+
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+}
+
+} // namespace MuMiniZinc::detail
@@ -0,0 +1,154 @@
+#ifndef EXECUTOR_PROCESS_HPP
+#define EXECUTOR_PROCESS_HPP
+
+#include <algorithm>   // std::min
+#include <chrono>      // std::chrono::milliseconds, std::chrono::seconds
+#include <cstdint>     // std::uint64_t
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+#include <boost/asio/io_context.hpp>     // boost::asio::io_context
+#include <boost/system/error_code.hpp>   // boost::system::error_code
+#include <boost/utility/string_view.hpp> // boost::string_view
+
+#if defined(__unix__)
+#    include <boost/system/system_category.hpp> // boost::system::system_category
+
+#    include <sys/resource.h> // getrlimit, rlimit, RLIMIT_AS, RLIMIT_CPU, setrlimit
+
+#    include <cerrno> // errno
+#endif
+
+#if defined(__linux__)
+#    include <sched.h> // cpu_set_t, sched_setaffinity
+#endif
+
+/**
+ * @file
+ * @brief The processes of the executions: their arguments, the resources they are given and the threads that handle them.
+ */
+namespace MuMiniZinc::detail
+{
+
+constexpr std::chrono::milliseconds spawn_retry_delay { 100 };
+constexpr std::uint64_t max_spawn_retries { 50 };
+
+/** How long a process may run past the time limit given to the compiler before it is stopped. */
+constexpr std::chrono::seconds time_limit_margin { 5 };
+
+/** Checks whether spawning a process has failed because the system has run out of file descriptors or processes. */
+[[nodiscard]] bool is_resource_exhausted(const boost::system::error_code& error_code) noexcept;
+
+/** Replaces every occurrence of a placeholder in a command argument. */
+void replace_all(std::string& text, std::string_view placeholder, std::string_view value);
+
+/** Returns the amount of threads that each compiler execution will use, from `-p` or `--parallel`. */
+[[nodiscard]] std::uint64_t get_solver_threads(std::span<const std::string_view> compiler_arguments) noexcept;
+
+/**
+ * Sets the amount of threads of the solver: every `-p`, `--parallel` or `--parallel=` of the arguments
+ * is removed along with its value, and `-p` is added with the new one.
+ */
+void set_solver_threads(std::vector<boost::string_view>& arguments, boost::string_view threads);
+
+/** Computes the amount of concurrent jobs to use when the user does not specify it. */
+[[nodiscard]] std::uint64_t get_default_n_jobs(std::span<const std::string_view> compiler_arguments) noexcept;
+
+/**
+ * The job slots of a scheduler, numbered from zero, of which every running execution holds one or more.
+ * Every slot may get CPUs of its own, for pinning the executions or giving them to a launcher.
+ */
+class JobSlots
+{
+public:
+    /**
+     * @param n_slots the amount of slots.
+     * @param cpus_per_slot the amount of CPUs of every slot.
+     * @param with_cpus whether to give every slot its CPUs.
+     */
+    JobSlots(std::uint64_t n_slots, std::uint64_t cpus_per_slot, bool with_cpus);
+
+    /** Takes up to \p count free slots, and returns their numbers. */
+    [[nodiscard]] std::vector<std::uint64_t> take(std::uint64_t count);
+
+    /** Frees slots taken through take. */
+    void release(std::span<const std::uint64_t> slots) noexcept;
+
+    /** Returns the CPUs of some slots, or none if the slots have no CPUs. */
+    [[nodiscard]] std::vector<std::uint64_t> get_cpus(std::span<const std::uint64_t> slots) const;
+
+private:
+    std::vector<bool> m_busy;
+    std::vector<std::vector<std::uint64_t>> m_cpus;
+};
+
+#if defined(__unix__)
+/**
+ * An initializer of Boost.Process that sets the resource limits of the child and pins it to its CPUs,
+ * from the child itself before it runs its executable, so its own children inherit them too.
+ */
+struct ChildSetup
+{
+#    if defined(__linux__)
+    /** The CPUs, or `nullptr` not to pin the child. */
+    const cpu_set_t* cpus {};
+#    endif
+
+    /** The limit of the address space in bytes, or zero for no limit. */
+    std::uint64_t memory_limit {};
+
+    /** The limit of the CPU time, or zero for no limit. */
+    std::chrono::seconds cpu_time_limit {};
+
+    template<typename Launcher, typename Path>
+    boost::system::error_code on_exec_setup(Launcher& /* launcher */, const Path& /* executable */, const char* const*& /* arguments */) const noexcept
+    {
+#    if defined(__linux__)
+        // The pinning is only an optimization, so the execution runs anyway if it fails.
+        if (cpus != nullptr)
+            ::sched_setaffinity(0, sizeof(cpu_set_t), cpus);
+#    endif
+
+        // The limits can only be lowered below the hard limits of this process.
+        const auto set_limit = [](int resource, ::rlim_t soft_limit, ::rlim_t hard_limit)
+        {
+            ::rlimit limit {};
+
+            if (::getrlimit(resource, &limit) != 0)
+                return false;
+
+            limit.rlim_cur = std::min(soft_limit, limit.rlim_max);
+            limit.rlim_max = std::min(hard_limit, limit.rlim_max);
+
+            return ::setrlimit(resource, &limit) == 0;
+        };
+
+        if (memory_limit != 0 && !set_limit(RLIMIT_AS, static_cast<::rlim_t>(memory_limit), static_cast<::rlim_t>(memory_limit)))
+            return boost::system::error_code { errno, boost::system::system_category() };
+
+        // The process gets SIGXCPU at the soft limit, and SIGKILL at the hard limit if it handles the signal.
+        const auto cpu_seconds = static_cast<::rlim_t>(cpu_time_limit.count());
+
+        if (cpu_seconds != 0 && !set_limit(RLIMIT_CPU, cpu_seconds, cpu_seconds + 1))
+            return boost::system::error_code { errno, boost::system::system_category() };
+
+        return {};
+    }
+};
+#endif
+
+/**
+ * Runs the handlers of a context until there is no more work, on several threads.
+ *
+ * @param ctx the context.
+ * @param n_threads the amount of threads, including this one.
+ *
+ * @throws std::exception the first exception thrown by a handler, after stopping the context and joining the threads.
+ */
+void run_handlers(boost::asio::io_context& ctx, std::uint64_t n_threads);
+
+} // namespace MuMiniZinc::detail
+
+#endif
@@ -0,0 +1,146 @@
+#include <executor/result_cache.hpp>
+
+#include <charconv>     // std::from_chars
+#include <chrono>       // std::chrono::microseconds
+#include <cstdint>      // std::int64_t, std::uint64_t
+#include <format>       // std::format
+#include <fstream>      // std::ifstream
+#include <ios>          // std::dec, std::hex
+#include <istream>      // std::istream
+#include <optional>     // std::optional
+#include <sstream>      // std::istringstream
+#include <string>       // std::getline, std::string
+#include <system_error> // std::errc, std::error_code
+#include <utility>      // std::move, std::to_underlying
+
+#include <muminizinc/logging.hpp>  // logging::code, logging::Color, logging::path_to_utf8, logging::Style
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry, MuMiniZinc::IOError
+
+#include <executor/files.hpp>   // MuMiniZinc::detail::write_file
+#include <executor/journal.hpp> // MuMiniZinc::detail::append_record, MuMiniZinc::detail::record_file_header
+
+namespace
+{
+
+/** Reads a resource of a record, which is `-` if it has not been measured. */
+[[nodiscard]] bool read_resource(std::istream& stream, std::optional<std::int64_t>& value)
+{
+    std::string field;
+
+    if (!(stream >> field))
+        return false;
+
+    if (field == "-")
+    {
+        value.reset();
+        return true;
+    }
+
+    std::int64_t number {};
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), number);
+
+    if (error != std::errc {} || end != field.data() + field.size() || number < 0)
+        return false;
+
+    value = number;
+    return true;
+}
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+void ResultCache::load(const std::filesystem::path& path)
+{
+    std::ifstream file { path };
+
+    if (!file.is_open())
+        return;
+
+    std::string line;
+
+    if (!std::getline(file, line) || line != record_file_header)
+        return;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream stream { line };
+
+        std::uint64_t key {};
+        std::uint64_t status {};
+        std::int64_t wall_time {};
+        std::optional<std::int64_t> user_time;
+        std::optional<std::int64_t> system_time;
+        std::optional<std::int64_t> max_rss;
+        Record record;
+
+        if (!(stream >> std::hex >> key >> std::dec >> status >> wall_time) || status > std::to_underlying(MuMiniZinc::Entry::Status::LimitExceeded))
+            continue;
+
+        if (!read_resource(stream, user_time) || !read_resource(stream, system_time) || !read_resource(stream, max_rss))
+            continue;
+
+        const auto to_microseconds = [](std::int64_t time)
+        { return std::chrono::microseconds { time }; };
+
+        const auto to_bytes = [](std::int64_t bytes)
+        { return static_cast<std::uint64_t>(bytes); };
+
+        record.status = static_cast<MuMiniZinc::Entry::Status>(status);
+        record.usage.wall_time = std::chrono::microseconds { wall_time };
+        record.usage.user_time = user_time.transform(to_microseconds);
+        record.usage.system_time = system_time.transform(to_microseconds);
+        record.usage.max_rss = max_rss.transform(to_bytes);
+
+        // An interrupted execution must run again.
+        if (record.status != MuMiniZinc::Entry::Status::Interrupted)
+            m_records.insert_or_assign(key, std::move(record));
+    }
+}
+
+const ResultCache::Record* ResultCache::find(std::uint64_t key) const noexcept
+{
+    const auto found = m_records.find(key);
+    return found == m_records.end() ? nullptr : &found->second;
+}
+
+void ResultCache::store(std::uint64_t key, MuMiniZinc::Entry::Status status, const MuMiniZinc::Entry::Usage& usage)
+{
+    if (status == MuMiniZinc::Entry::Status::Interrupted || status == MuMiniZinc::Entry::Status::LimitExceeded)
+        return;
+
+    Record record { .status = status, .usage = usage };
+    record.usage.statistics.clear();
+
+    m_records.insert_or_assign(key, std::move(record));
+}
+
+void ResultCache::save(const std::filesystem::path& path) const
+{
+    std::string contents { record_file_header };
+    contents.push_back('\n');
+
+    for (const auto& [key, record] : m_records)
+    {
+        // The results loaded from a journal may depend on the limits of its run.
+        if (record.status == MuMiniZinc::Entry::Status::LimitExceeded)
+            continue;
+
+        append_record(contents, key, record.status, record.usage);
+        contents.push_back('\n');
+    }
+
+    auto temporary_path = path;
+    temporary_path += ".tmp";
+
+    write_file(temporary_path, contents);
+
+    std::error_code error_code;
+    std::filesystem::rename(temporary_path, path, error_code);
+
+    if (error_code)
+        throw MuMiniZinc::IOError { std::format("Could not write to the file `{:s}{:s}{:s}`.", logging::code(logging::Color::Blue), logging::path_to_utf8(path), logging::code(logging::Style::Reset)) };
+}
+
+} // namespace MuMiniZinc::detail
@@ -0,0 +1,58 @@
+#ifndef EXECUTOR_RESULT_CACHE_HPP
+#define EXECUTOR_RESULT_CACHE_HPP
+
+#include <cstdint>       // std::uint64_t
+#include <filesystem>    // std::filesystem::path
+#include <unordered_map> // std::unordered_map
+
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+/**
+ * @file
+ * @brief The results of previous runs, so the executions whose results are known are not run again.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** The results of previous runs, stored in a file in the format of the journal. */
+class ResultCache
+{
+public:
+    /** The result of an execution. */
+    struct Record
+    {
+        MuMiniZinc::Entry::Status status {};
+        MuMiniZinc::Entry::Usage usage;
+    };
+
+    /**
+     * Loads the records of a file, replacing those with the same key. A missing file adds nothing, and
+     * lines that cannot be parsed are skipped.
+     *
+     * @param path the path of the file, which may be a cache or a journal.
+     */
+    void load(const std::filesystem::path& path);
+
+    /** Returns the result of an execution, if it is in the cache. */
+    [[nodiscard]] const Record* find(std::uint64_t key) const noexcept;
+
+    /**
+     * Stores the result of an execution. Its statistics are not kept, and interrupted executions are not
+     * stored, nor those that exceeded the resource limits, which are not part of the key.
+     */
+    void store(std::uint64_t key, MuMiniZinc::Entry::Status status, const MuMiniZinc::Entry::Usage& usage);
+
+    /**
+     * Writes the cache to a file, through a temporary file that replaces it, so an interrupted write does not lose it.
+     *
+     * @throws MuMiniZinc::IOError if the file cannot be written.
+     */
+    void save(const std::filesystem::path& path) const;
+
+private:
+    std::unordered_map<std::uint64_t, Record> m_records;
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
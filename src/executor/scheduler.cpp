@@ -0,0 +1,960 @@
+#include <executor/scheduler.hpp>
+
+#include <algorithm>    // std::max, std::min
+#include <array>        // std::array
+#include <chrono>       // std::chrono::seconds, std::chrono::steady_clock
+#include <csignal>      // SIGINT, SIGKILL, SIGTERM, SIGXCPU
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstdlib>      // EXIT_FAILURE, EXIT_SUCCESS
+#include <exception>    // std::current_exception, std::exception_ptr, std::make_exception_ptr, std::rethrow_exception
+#include <filesystem>   // std::filesystem::create_directory, std::filesystem::path, std::filesystem::remove_all
+#include <format>       // std::format, std::format_to
+#include <iterator>     // std::back_inserter
+#include <memory>       // std::make_shared, std::make_unique, std::shared_ptr, std::unique_ptr
+#include <optional>     // std::optional
+#include <ranges>       // std::ranges::size
+#include <span>         // std::span
+#include <string>       // std::string, std::to_string
+#include <string_view>  // std::string_view
+#include <system_error> // std::error_code
+#include <type_traits>  // std::is_same_v
+#include <utility>      // std::exchange, std::move
+#include <vector>       // std::vector
+
+#include <boost/asio/any_io_executor.hpp>   // boost::asio::any_io_executor
+#include <boost/asio/buffer.hpp>            // boost::asio::buffer
+#include <boost/asio/dispatch.hpp>          // boost::asio::dispatch
+#include <boost/asio/error.hpp>             // boost::asio::error::broken_pipe, boost::asio::error::eof, boost::asio::error::operation_aborted
+#include <boost/asio/io_context.hpp>        // boost::asio::io_context
+#include <boost/asio/post.hpp>              // boost::asio::post
+#include <boost/asio/readable_pipe.hpp>     // boost::asio::readable_pipe
+#include <boost/asio/signal_set.hpp>        // boost::asio::signal_set
+#include <boost/asio/steady_timer.hpp>      // boost::asio::steady_timer
+#include <boost/asio/strand.hpp>            // boost::asio::make_strand, boost::asio::strand
+#include <boost/asio/writable_pipe.hpp>     // boost::asio::writable_pipe
+#include <boost/asio/write.hpp>             // boost::asio::async_write
+#include <boost/process/v2/environment.hpp> // boost::process::environment::current, boost::process::environment::key_value_pair, boost::process::process_environment
+#include <boost/process/v2/process.hpp>     // boost::process::process
+#include <boost/process/v2/stdio.hpp>       // boost::process::process_stdio
+#include <boost/system/error_code.hpp>      // boost::system::error_code
+#include <boost/system/system_error.hpp>    // boost::system::system_error
+#include <boost/utility/string_view.hpp>    // boost::string_view
+
+#if defined(__unix__)
+#    include <boost/process/v2/posix/vfork_launcher.hpp> // boost::process::posix::vfork_launcher
+#endif
+
+#if defined(__linux__)
+#    include <boost/asio/posix/stream_descriptor.hpp> // boost::asio::posix::stream_descriptor
+#    include <boost/system/system_category.hpp>       // boost::system::system_category
+
+#    include <fcntl.h>        // fcntl, F_DUPFD_CLOEXEC
+#    include <sched.h>        // cpu_set_t, CPU_COUNT, CPU_SET, CPU_ZERO
+#    include <sys/resource.h> // rusage
+#    include <sys/time.h>     // timeval
+#    include <sys/types.h>    // pid_t
+#    include <sys/wait.h>     // wait4, WEXITSTATUS, WIFEXITED, WIFSIGNALED, WTERMSIG
+
+#    include <cerrno> // errno
+#endif
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::ExecutionError, MuMiniZinc::execution_args
+#include <muminizinc/logging.hpp>  // logging::path_to_utf8
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+#include <executor/files.hpp>   // MuMiniZinc::detail::ScratchDirectory
+#include <executor/job.hpp>     // MuMiniZinc::detail::complete_job, MuMiniZinc::detail::ExecutionJob, MuMiniZinc::detail::ExecutionResult, MuMiniZinc::detail::Progress, MuMiniZinc::detail::record_result
+#include <executor/process.hpp> // MuMiniZinc::detail::ChildSetup, MuMiniZinc::detail::JobSlots, MuMiniZinc::detail::run_handlers
+
+namespace
+{
+
+/** How much of the end of the output of a diverged execution is kept, for finding the report of the time limit. */
+constexpr std::size_t divergence_tail_size { 4 * 1024 };
+
+/** How long a process whose output has diverged is given to exit before it is killed. */
+constexpr std::chrono::seconds termination_grace_period { 1 };
+
+} // namespace
+
+namespace MuMiniZinc::detail
+{
+
+BufferPool::Buffer BufferPool::acquire()
+{
+    if (m_buffers.empty())
+        return std::make_unique<std::array<char, read_buffer_size>>();
+
+    auto buffer = std::move(m_buffers.back());
+    m_buffers.pop_back();
+
+    return buffer;
+}
+
+void BufferPool::release(Buffer buffer)
+{
+    if (buffer != nullptr)
+        m_buffers.push_back(std::move(buffer));
+}
+
+template<ExecutionJob Job>
+struct Scheduler<Job>::Execution
+{
+    Execution(boost::asio::io_context& ctx, Job job) :
+        job { std::move(job) }, strand { boost::asio::make_strand(ctx) }, in_pipe { strand }, out_pipe { strand }, err_pipe { strand }, kill_timer { strand }, time_limit_timer { strand } { }
+
+    Job job;
+    Strand strand;
+    std::unique_ptr<boost::process::process> process;
+    boost::asio::writable_pipe in_pipe;
+    boost::asio::readable_pipe out_pipe;
+    boost::asio::readable_pipe err_pipe;
+    boost::asio::steady_timer kill_timer;
+    boost::asio::steady_timer time_limit_timer;
+    BufferPool::Buffer buffer;
+    BufferPool::Buffer error_buffer;
+    std::filesystem::path temporary_directory;
+    std::chrono::steady_clock::time_point start_time;
+    MuMiniZinc::Entry::Usage usage;
+#if defined(__linux__) && defined(BOOST_PROCESS_V2_PIDFD_OPEN)
+    /** A duplicate of the pidfd of the process handle, so it can be reaped with `wait4` to get its resource usage. */
+    std::optional<boost::asio::posix::stream_descriptor> process_descriptor;
+#endif
+    /** How many jobs the execution counts as, which is more than one if its solver has been given more threads. */
+    std::uint64_t slots { 1 };
+
+template<ExecutionJob Job>
+Scheduler<Job>::Scheduler(boost::asio::io_context& ctx, const MuMiniZinc::execution_args& parameters, std::span<boost::string_view> arguments, std::deque<Job>& jobs, std::uint64_t max_jobs, Progress& progress, const ScratchDirectory* scratch_directory, std::atomic<bool>* interrupted) :
+    m_ctx { ctx }, m_parameters { parameters }, m_arguments { arguments }, m_jobs { jobs }, m_max_jobs { max_jobs }, m_limit { max_jobs }, m_progress { progress }, m_strand { boost::asio::make_strand(ctx) }, m_retry_timer { m_strand }, m_scratch_directory { scratch_directory }, m_solver_threads { get_solver_threads(parameters.compiler_arguments) }, m_slots { max_jobs, m_solver_threads, parameters.pin_cpus || !parameters.launcher.empty() }, m_interrupted { interrupted }
+{
+    if (m_scratch_directory == nullptr)
+        return;
+
+    for (const auto variable : boost::process::environment::current())
+    {
+        if (variable.key().string() != temporary_directory_variable)
+            m_environment.emplace_back(variable);
+    }
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::run(std::uint64_t n_threads)
+{
+    // The signals are only caught while the jobs run, so they are not swallowed by a signal set that is no longer waited on.
+    if (m_interrupted != nullptr)
+    {
+        m_signals.emplace(m_strand, SIGINT, SIGTERM);
+        m_signals->async_wait([this](boost::system::error_code ec, int /* signal */)
+            {
+                if (!ec)
+                    interrupt(); });
+    }
+
+    fill();
+    run_handlers(m_ctx, n_threads);
+
+    m_signals.reset();
+
+    if (m_error != nullptr)
+        std::rethrow_exception(m_error);
+}
+
+   /** The job slots held by the execution. */
+    std::vector<std::uint64_t> slot_indices;
+    /** The number of the execution, unique among the executions of the scheduler. */
+    std::uint64_t job_id {};
+
+    /** The output that has not been matched yet, if the output is compared while it is read. */
+    std::optional<std::string_view> expected;
+    /** The output, if it is captured instead. */
+    std::string output;
+    std::string error_output;
+    /** The end of the output that does not form a line yet, when the statistics lines are removed from it. */
+    std::string partial_line;
+    /** The end of the output since a little before it diverged, while the process is being stopped. */
+    std::string divergence_tail;
+
+    bool received {};
+    bool diverged {};
+    bool too_long {};
+    bool timed_out {};
+    bool interrupted {};
+    /** Whether the process has been asked to exit while it was running. */
+    bool stop_requested {};
+    bool exited {};
+    bool input_closed {};
+    bool output_closed {};
+    bool error_closed {};
+    bool wait_failed {};
+    /** The signal that has terminated the process, if it is known, or zero. */
+    int termination_signal {};
+    /** Whether the execution has been handed over to the strand of the scheduler. */
+    bool finished {};
+    int exit_code {};
+};
+
+template<ExecutionJob Job>
+void Scheduler<Job>::fill()
+{
+    try
+    {
+        if (m_interrupted != nullptr && m_interrupted->load())
+            drop_jobs();
+
+        while (m_error == nullptr && m_running < m_limit && !m_jobs.empty() && launch()) { }
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+
+    // Once everything has finished, stop waiting for signals, so the context runs out of work.
+    if (m_running == 0 && m_jobs.empty() && m_signals.has_value())
+        m_signals->cancel();
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::fail(std::exception_ptr error)
+{
+    if (m_error == nullptr)
+        m_error = std::move(error);
+
+    m_jobs.clear();
+    m_retry_timer.cancel();
+
+    for (const auto& execution : m_executions)
+    {
+        boost::asio::dispatch(execution->strand, [execution]
+            {
+                if (!execution->exited)
+                    stop(execution); });
+    }
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::interrupt()
+{
+    m_interrupted->store(true);
+
+    for (const auto& execution : m_executions)
+    {
+        boost::asio::dispatch(execution->strand, [execution]
+            {
+                // Once the process has exited, the execution may already have been handed over to the strand
+                // of the scheduler, which reads its flags, so they are only written while it is running.
+                // The result of the executions that are already being stopped is known.
+                if (execution->exited || execution->diverged || execution->too_long || execution->timed_out)
+                    return;
+
+                execution->interrupted = true;
+                stop(execution); });
+    }
+
+    fill();
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::drop_jobs()
+{
+    // The callbacks of the stages may queue more jobs, which are dropped too.
+    while (!m_jobs.empty())
+    {
+        auto job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        if constexpr (std::is_same_v<Job, StageJob>)
+            job.on_complete(ExecutionResult { .interrupted = true });
+        else
+        {
+            m_progress.advance();
+
+            if constexpr (std::is_same_v<Job, MutantJob>)
+            {
+                // The mutant has already been found invalid with another data file.
+                if (*job.status == MuMiniZinc::Entry::Status::Invalid)
+                    continue;
+            }
+
+            record_result(job, ExecutionResult { .interrupted = true }, m_progress);
+        }
+    }
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::back_off()
+{
+    m_limit = std::max(m_running, std::uint64_t { 1 });
+
+    // Nothing is running, so no completion will admit new jobs. Try again later.
+    if (m_running != 0)
+        return;
+
+    if (++m_failed_spawns > max_spawn_retries)
+    {
+        m_progress.output().println();
+        throw MuMiniZinc::ExecutionError { "Cannot launch the compiler: The system has run out of resources." };
+    }
+
+    m_retry_timer.expires_after(spawn_retry_delay);
+    m_retry_timer.async_wait([this](boost::system::error_code ec)
+        {
+            if (!ec)
+                fill(); });
+}
+
+template<ExecutionJob Job>
+[[nodiscard]] const std::string* Scheduler<Job>::get_expected_output(const Job& job) noexcept
+{
+    if constexpr (std::is_same_v<Job, MutantJob>)
+        return job.original_output;
+    else if constexpr (std::is_same_v<Job, StageJob>)
+        return job.expected_output;
+    else
+        return nullptr;
+}
+
+template<ExecutionJob Job>
+bool Scheduler<Job>::launch()
+{
+    // A job that has not run yet can only be invalid if its mutant has been found invalid with another data file.
+    if constexpr (std::is_same_v<Job, MutantJob>)
+    {
+        if (*m_jobs.front().status == MuMiniZinc::Entry::Status::Invalid)
+        {
+            m_jobs.pop_front();
+            m_progress.advance();
+
+            return true;
+        }
+    }
+    else if constexpr (std::is_same_v<Job, StageJob>)
+    {
+        if (m_jobs.front().status != nullptr && *m_jobs.front().status == MuMiniZinc::Entry::Status::Invalid)
+        {
+            auto job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+
+            job.on_complete(ExecutionResult {});
+
+            return true;
+        }
+    }
+
+    auto execution = std::make_shared<Execution>(m_ctx, std::move(m_jobs.front()));
+    m_jobs.pop_front();
+
+    execution->job_id = m_launched++;
+
+    auto& job = execution->job;
+
+    if constexpr (!std::is_same_v<Job, StageJob>)
+    {
+        if (!job.data_file.empty())
+            m_arguments.back() = boost::string_view { job.data_file.data(), job.data_file.size() };
+
+        // The model is either piped or read from its file.
+        m_arguments.front() = job.model_path.empty() ? boost::string_view { "-" } : boost::string_view { job.model_path.data(), job.model_path.size() };
+    }
+
+    std::vector<boost::string_view> boosted_arguments;
+    std::string boosted_threads;
+
+    if constexpr (std::is_same_v<Job, MutantJob>)
+    {
+        // The job itself has already been taken from the queue.
+        const auto queued_jobs = m_jobs.size() + 1;
+        const auto free_slots = m_limit - m_running;
+
+        if (m_parameters.boost_tail_threads && queued_jobs < free_slots)
+        {
+            execution->slots = free_slots / queued_jobs;
+            boosted_threads = std::to_string(execution->slots * m_solver_threads);
+
+            boosted_arguments.assign(m_arguments.begin(), m_arguments.end());
+            set_solver_threads(boosted_arguments, boosted_threads);
+        }
+    }
+
+    std::vector<boost::process::environment::key_value_pair> environment;
+
+    if (m_scratch_directory != nullptr)
+    {
+        execution->temporary_directory = m_scratch_directory->path() / std::format("job-{:d}", execution->job_id);
+        std::filesystem::create_directory(execution->temporary_directory);
+
+        environment = m_environment;
+        environment.emplace_back(temporary_directory_variable, logging::path_to_utf8(execution->temporary_directory));
+    }
+
+    execution->slot_indices = m_slots.take(execution->slots);
+
+#if defined(__unix__)
+    ChildSetup setup { .memory_limit = m_parameters.memory_limit, .cpu_time_limit = m_parameters.cpu_time_limit };
+#endif
+
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+
+    for (const auto cpu : m_slots.get_cpus(execution->slot_indices))
+        CPU_SET(cpu, &cpus);
+
+    if (m_parameters.pin_cpus && CPU_COUNT(&cpus) > 0)
+        setup.cpus = &cpus;
+#endif
+
+    try
+    {
+        const auto launch_process = [&](const std::filesystem::path& executable, const auto& arguments, const auto&... initializers)
+        {
+            const boost::process::process_stdio stdio { .in = execution->in_pipe, .out = execution->out_pipe, .err = execution->err_pipe };
+
+#if defined(__unix__)
+            // vfork does not copy the page tables of this process, which grow with the mutants held in memory.
+            if (m_parameters.use_vfork)
+                return std::make_unique<boost::process::process>(boost::process::posix::vfork_launcher {}(boost::asio::any_io_executor { execution->strand }, executable, arguments, stdio, setup, initializers...));
+
+            return std::make_unique<boost::process::process>(execution->strand, executable, arguments, stdio, setup, initializers...);
+#else
+            return std::make_unique<boost::process::process>(execution->strand, executable, arguments, stdio, initializers...);
+#endif
+        };
+
+        const auto spawn_executable = [&](const std::filesystem::path& executable, const auto& arguments)
+        {
+            if (environment.empty())
+                return launch_process(executable, arguments);
+
+            return launch_process(executable, arguments, boost::process::process_environment { environment });
+        };
+
+        // The launcher gets the pipes, and runs the compiler with them.
+        const auto spawn = [&](const auto& arguments)
+        {
+            if (m_parameters.launcher.empty())
+                return spawn_executable(m_parameters.compiler_path.get(), arguments);
+
+            return spawn_executable(std::filesystem::path { m_parameters.launcher.front() }, get_launcher_arguments(*execution, arguments));
+        };
+
+        if constexpr (std::is_same_v<Job, StageJob>)
+            execution->process = spawn(job.arguments);
+        else if (!boosted_arguments.empty())
+            execution->process = spawn(boosted_arguments);
+        else
+            execution->process = spawn(m_arguments);
+    }
+    catch (const boost::system::system_error& error)
+    {
+        remove_temporary_directory(*execution);
+        m_slots.release(execution->slot_indices);
+
+        if (!is_resource_exhausted(error.code()))
+            throw;
+
+        m_jobs.push_front(std::move(job));
+        back_off();
+
+        return false;
+    }
+
+    m_running += execution->slots;
+    m_failed_spawns = 0;
+    m_executions.push_back(execution);
+
+    execution->start_time = std::chrono::steady_clock::now();
+
+    if (const auto* expected_output = get_expected_output(job); expected_output != nullptr)
+        execution->expected = *expected_output;
+
+    execution->buffer = m_buffers.acquire();
+    execution->error_buffer = m_buffers.acquire();
+
+    boost::asio::dispatch(execution->strand, [this, execution]
+        { start(execution); });
+
+    return true;
+}
+
+template<ExecutionJob Job>
+template<typename Arguments>
+[[nodiscard]] std::vector<std::string> Scheduler<Job>::get_launcher_arguments(const Execution& execution, const Arguments& arguments) const
+{
+    std::string cpus;
+
+    for (const auto cpu : m_slots.get_cpus(execution.slot_indices))
+        std::format_to(std::back_inserter(cpus), "{:s}{:d}", cpus.empty() ? "" : ",", cpu);
+
+    const auto slot = std::to_string(execution.slot_indices.empty() ? 0 : execution.slot_indices.front());
+    const auto job_id = std::to_string(execution.job_id);
+
+    std::vector<std::string> launcher_arguments;
+    launcher_arguments.reserve(m_parameters.launcher.size() + std::ranges::size(arguments));
+
+    for (const auto& argument : m_parameters.launcher.subspan(1))
+    {
+        auto& expanded = launcher_arguments.emplace_back(argument);
+
+        replace_all(expanded, "{slot}", slot);
+        replace_all(expanded, "{cpu}", cpus);
+        replace_all(expanded, "{job}", job_id);
+    }
+
+    launcher_arguments.push_back(logging::path_to_utf8(m_parameters.compiler_path.get()));
+
+    for (const auto& argument : arguments)
+        launcher_arguments.emplace_back(argument.data(), argument.size());
+
+    return launcher_arguments;
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::start(const std::shared_ptr<Execution>& execution)
+{
+    write_input(execution);
+    read_output(execution);
+    read_error(execution);
+    enforce_time_limit(execution);
+
+#if defined(__linux__) && defined(BOOST_PROCESS_V2_PIDFD_OPEN)
+    if (wait_with_usage(execution))
+        return;
+#endif
+
+    execution->process->async_wait([this, execution](boost::system::error_code ec, int exit_code)
+        { on_process_exit(execution, ec, exit_code); });
+}
+
+#if defined(__linux__) && defined(BOOST_PROCESS_V2_PIDFD_OPEN)
+template<ExecutionJob Job>
+bool Scheduler<Job>::wait_with_usage(const std::shared_ptr<Execution>& execution)
+{
+    const auto pid = static_cast<pid_t>(execution->process->id());
+
+    // The pidfd is the one the handle has opened when spawning the process, so it cannot refer to another one.
+    // It is duplicated because the handle has already registered it for the context.
+    if (execution->process->native_handle() < 0)
+        return false;
+
+    const auto descriptor = ::fcntl(execution->process->native_handle(), F_DUPFD_CLOEXEC, 0);
+
+    if (descriptor < 0)
+        return false;
+
+    execution->process_descriptor.emplace(execution->strand, descriptor);
+    execution->process_descriptor->async_wait(boost::asio::posix::stream_descriptor::wait_read, [this, execution, pid](boost::system::error_code ec)
+        {
+            int status {};
+            ::rusage usage {};
+
+            // The descriptor is readable once the process has exited, so this does not block.
+            if (!ec && ::wait4(pid, &status, 0, &usage) != pid)
+                ec.assign(errno, boost::system::system_category());
+
+            boost::system::error_code error_code;
+            execution->process_descriptor->close(error_code);
+
+            if (ec)
+            {
+                on_process_exit(execution, ec, EXIT_FAILURE);
+                return;
+            }
+
+            // The process has been reaped here, so its handle must forget about it.
+            execution->process->detach();
+
+            const auto to_microseconds = [](const ::timeval& time)
+            { return std::chrono::seconds { time.tv_sec } + std::chrono::microseconds { time.tv_usec }; };
+
+            execution->usage.user_time = to_microseconds(usage.ru_utime);
+            execution->usage.system_time = to_microseconds(usage.ru_stime);
+            execution->usage.max_rss = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // Linux reports it in kibibytes.
+            execution->termination_signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+
+            on_process_exit(execution, ec, WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE); });
+
+    return true;
+}
+#endif
+
+template<ExecutionJob Job>
+void Scheduler<Job>::enforce_time_limit(const std::shared_ptr<Execution>& execution)
+{
+    if (m_parameters.timeout == std::chrono::seconds::zero())
+        return;
+
+    execution->time_limit_timer.expires_after(m_parameters.timeout + time_limit_margin);
+    execution->time_limit_timer.async_wait([execution](boost::system::error_code ec)
+        {
+            if (ec || execution->exited)
+                return;
+
+            execution->timed_out = true;
+            stop(execution); });
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::on_process_exit(const std::shared_ptr<Execution>& execution, boost::system::error_code ec, int exit_code)
+{
+    execution->exited = true;
+    execution->wait_failed = static_cast<bool>(ec);
+    execution->exit_code = exit_code;
+    execution->usage.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - execution->start_time);
+    execution->kill_timer.cancel();
+    execution->time_limit_timer.cancel();
+
+    // The process has been stopped, so whatever is left in the pipes does not matter, except for the end of the
+    // output of a diverged process, which may report the time limit. The pipes may be held open by the processes
+    // it has started, so it is only read for the grace period.
+    if (execution->too_long || execution->timed_out || execution->interrupted)
+        close_pipes(*execution);
+    else if (execution->diverged)
+    {
+        execution->kill_timer.expires_after(termination_grace_period);
+        execution->kill_timer.async_wait([execution](boost::system::error_code ec)
+            {
+                if (!ec && !execution->finished)
+                    close_pipes(*execution); });
+    }
+
+    finish(execution);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::close_pipes(Execution& execution)
+{
+    boost::system::error_code error_code;
+    execution.in_pipe.close(error_code);
+    execution.out_pipe.close(error_code);
+    execution.err_pipe.close(error_code);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::write_input(const std::shared_ptr<Execution>& execution)
+{
+    const auto close_input = [this](const std::shared_ptr<Execution>& execution)
+    {
+        boost::system::error_code error_code;
+        execution->in_pipe.close(error_code);
+
+        execution->input_closed = true;
+        finish(execution);
+    };
+
+    if (execution->job.contents.empty())
+    {
+        close_input(execution);
+        return;
+    }
+
+    boost::asio::async_write(execution->in_pipe, boost::asio::buffer(execution->job.contents), [this, execution, close_input](boost::system::error_code ec, std::size_t)
+        {
+            // The process may exit, or be stopped, without reading all of its input.
+            if (ec && ec != boost::asio::error::eof && ec != boost::asio::error::broken_pipe && ec != boost::asio::error::operation_aborted)
+            {
+                boost::asio::post(m_strand, [this]
+                    { fail(std::make_exception_ptr(MuMiniZinc::ExecutionError { "Cannot write the input." })); });
+            }
+
+            close_input(execution); });
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::read_output(std::shared_ptr<Execution> execution)
+{
+    auto& buffer = *execution->buffer;
+
+    execution->out_pipe.async_read_some(boost::asio::buffer(buffer), [this, execution](boost::system::error_code ec, std::size_t size)
+        {
+            consume_lines(execution, std::string_view { execution->buffer->data(), size });
+
+            if (ec)
+            {
+                // The output may not end with a new line.
+                if (!execution->partial_line.empty())
+                    consume_line(execution, std::exchange(execution->partial_line, {}));
+
+                execution->output_closed = true;
+                finish(execution);
+                return;
+            }
+
+            read_output(execution); });
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::read_error(std::shared_ptr<Execution> execution)
+{
+    auto& buffer = *execution->error_buffer;
+
+    execution->err_pipe.async_read_some(boost::asio::buffer(buffer), [this, execution](boost::system::error_code ec, std::size_t size)
+        {
+            // Keep reading past the limit, so the process does not block on a full pipe.
+            append_limited(execution->error_output, std::string_view { execution->error_buffer->data(), size }, m_parameters.max_error_size);
+
+            if (ec)
+            {
+                execution->error_closed = true;
+                finish(execution);
+                return;
+            }
+
+            read_error(execution); });
+}
+
+template<ExecutionJob Job>
+bool Scheduler<Job>::append_limited(std::string& output, std::string_view chunk, std::uint64_t limit)
+{
+    if (limit == 0 || output.size() + chunk.size() <= limit)
+    {
+        output.append(chunk);
+        return true;
+    }
+
+    if (output.size() < limit)
+        output.append(chunk.substr(0, static_cast<std::size_t>(limit - output.size())));
+
+    return false;
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::consume_lines(const std::shared_ptr<Execution>& execution, std::string_view chunk)
+{
+    if (!m_parameters.statistics)
+    {
+        consume(execution, chunk);
+        return;
+    }
+
+    for (auto end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n'))
+    {
+        const auto line = chunk.substr(0, end + 1);
+        chunk.remove_prefix(line.size());
+
+        // Only the lines that are split between reads are copied.
+        if (execution->partial_line.empty())
+            consume_line(execution, line);
+        else
+            consume_line(execution, std::exchange(execution->partial_line, {}).append(line));
+    }
+
+    execution->partial_line.append(chunk);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::consume_line(const std::shared_ptr<Execution>& execution, std::string_view line)
+{
+    if (line.starts_with(statistics_prefix))
+        parse_statistics_line(line, execution->usage.statistics);
+    else
+        consume(execution, line);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::consume(const std::shared_ptr<Execution>& execution, std::string_view chunk)
+{
+    if (chunk.empty())
+        return;
+
+    execution->received = true;
+
+    if (execution->diverged)
+    {
+        append_tail(*execution, chunk);
+        return;
+    }
+
+    if (execution->too_long || execution->timed_out)
+        return;
+
+    if (!execution->expected.has_value())
+    {
+        if (!append_limited(execution->output, chunk, m_parameters.max_output_size))
+        {
+            execution->too_long = true;
+            stop(execution);
+        }
+
+        return;
+    }
+
+    auto& expected = *execution->expected;
+
+    if (expected.starts_with(chunk))
+    {
+        expected.remove_prefix(chunk.size());
+        return;
+    }
+
+    // The output is still read while the process is being stopped, and its end is checked once it has exited, as
+    // the report of the time limit may be split between reads or follow the divergence. The report may also start
+    // in the output that matched, like `% Time` before ` limit exceeded`.
+    const auto* expected_output = get_expected_output(execution->job);
+    const std::string_view matched { expected_output->data(), static_cast<std::size_t>(expected.data() - expected_output->data()) };
+
+    execution->diverged = true;
+    execution->divergence_tail = matched.substr(matched.size() - std::min(matched.size(), divergence_tail_size));
+    append_tail(*execution, chunk);
+    stop(execution);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::append_tail(Execution& execution, std::string_view chunk)
+{
+    execution.divergence_tail.append(chunk);
+
+    if (execution.divergence_tail.size() > divergence_tail_size)
+        execution.divergence_tail.erase(0, execution.divergence_tail.size() - divergence_tail_size);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::stop(const std::shared_ptr<Execution>& execution)
+{
+    if (execution->exited)
+        return;
+
+    boost::system::error_code error_code;
+    execution->process->request_exit(error_code);
+
+    execution->stop_requested = true;
+
+    execution->kill_timer.expires_after(termination_grace_period);
+    execution->kill_timer.async_wait([execution](boost::system::error_code ec)
+        {
+            if (ec || execution->exited)
+                return;
+
+            boost::system::error_code error_code;
+            execution->process->terminate(error_code); });
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::finish(const std::shared_ptr<Execution>& execution)
+{
+    if (execution->finished || !execution->exited || !execution->input_closed || !execution->output_closed || !execution->error_closed)
+        return;
+
+    execution->finished = true;
+    execution->kill_timer.cancel();
+
+    boost::asio::post(m_strand, [this, execution]
+        { complete(*execution); });
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::complete(Execution& execution)
+{
+    std::erase_if(m_executions, [&execution](const std::shared_ptr<Execution>& running)
+        { return running.get() == &execution; });
+
+    m_buffers.release(std::move(execution.buffer));
+    m_buffers.release(std::move(execution.error_buffer));
+    remove_temporary_directory(execution);
+
+    m_running -= execution.slots;
+    m_slots.release(execution.slot_indices);
+
+    if (m_limit < m_max_jobs)
+        ++m_limit;
+
+    if constexpr (!std::is_same_v<Job, StageJob>)
+        m_progress.advance();
+
+    // If an error occurred, don't do anything with the output.
+    if (!execution.wait_failed && m_error == nullptr)
+    {
+        try
+        {
+            on_exit(execution);
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    }
+
+    fill();
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::remove_temporary_directory(Execution& execution)
+{
+    if (execution.temporary_directory.empty())
+        return;
+
+    std::error_code error_code;
+    std::filesystem::remove_all(execution.temporary_directory, error_code);
+}
+
+template<ExecutionJob Job>
+[[nodiscard]] bool Scheduler<Job>::has_exceeded_limits(const Execution& execution) const
+{
+    if (execution.too_long)
+        return true;
+
+    if (m_parameters.cpu_time_limit != std::chrono::seconds::zero())
+    {
+#if defined(__unix__)
+        if (execution.termination_signal == SIGXCPU || (execution.termination_signal == SIGKILL && !execution.stop_requested))
+            return true;
+#endif
+
+        if (execution.error_output.contains(cpu_time_limit_report))
+            return true;
+    }
+
+    return m_parameters.memory_limit != 0 && is_out_of_memory_output(execution.error_output);
+}
+
+template<ExecutionJob Job>
+void Scheduler<Job>::on_exit(Execution& execution)
+{
+    // The time limit is reached at the end of the execution, so its report is at the end of the output.
+    if (execution.diverged && is_timeout_output(execution.divergence_tail))
+        execution.timed_out = true;
+
+    // A process stopped because its output has diverged fails because it has been stopped. One that has
+    // exited before it could be stopped may have diverged on its way to an error, so its exit code decides.
+    const auto stopped_on_divergence = execution.diverged && execution.stop_requested;
+
+    ExecutionResult result {
+        .success = !execution.interrupted && (stopped_on_divergence || (execution.exit_code == EXIT_SUCCESS && !execution.too_long && !execution.timed_out)),
+        .usage = execution.usage,
+        .timed_out = execution.timed_out,
+        .interrupted = execution.interrupted
+    };
+
+    if (!execution.stop_requested && !execution.timed_out && execution.termination_signal == 0)
+        result.exit_code = execution.exit_code;
+
+    result.limit_exceeded = !result.success && !result.timed_out && !result.interrupted && has_exceeded_limits(execution);
+
+    if (execution.too_long)
+        result.output = std::format("The output exceeds the limit of {:d} bytes.", m_parameters.max_output_size);
+    else if (execution.timed_out && !execution.diverged)
+        result.output = std::format("The execution has been stopped {:d} seconds after the time limit of {:d} seconds.", time_limit_margin.count(), m_parameters.timeout.count());
+    else if (result.limit_exceeded)
+        result.output = std::format("The execution has exceeded its resource limits:\n{:s}", execution.error_output);
+    else if (!result.success)
+        result.output = std::move(execution.error_output);
+    else if (execution.expected.has_value())
+    {
+        // Without any output, report it as missing instead of comparing it.
+        if (execution.received)
+            result.matches = !execution.diverged && execution.expected->empty();
+    }
+    else
+        result.output = std::move(execution.output);
+
+    if constexpr (std::is_same_v<Job, StageJob>)
+        execution.job.on_complete(std::move(result));
+    else
+        complete_job(execution.job, std::move(result), m_progress);
+}
+
+template class Scheduler<OriginalJob>;
+template class Scheduler<MutantJob>;
+template class Scheduler<StageJob>;
+
+} // namespace MuMiniZinc::detail
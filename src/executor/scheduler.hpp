@@ -0,0 +1,247 @@
+#ifndef EXECUTOR_SCHEDULER_HPP
+#define EXECUTOR_SCHEDULER_HPP
+
+#include <array>       // std::array
+#include <atomic>      // std::atomic
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <deque>       // std::deque
+#include <exception>   // std::exception_ptr
+#include <memory>      // std::shared_ptr, std::unique_ptr
+#include <optional>    // std::optional
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+#include <boost/asio/io_context.hpp>        // boost::asio::io_context
+#include <boost/asio/signal_set.hpp>        // boost::asio::signal_set
+#include <boost/asio/steady_timer.hpp>      // boost::asio::steady_timer
+#include <boost/asio/strand.hpp>            // boost::asio::strand
+#include <boost/process/v2/environment.hpp> // boost::process::environment::key_value_pair
+#include <boost/system/error_code.hpp>      // boost::system::error_code
+#include <boost/utility/string_view.hpp>    // boost::string_view
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::execution_args
+
+#include <executor/files.hpp>   // MuMiniZinc::detail::ScratchDirectory
+#include <executor/job.hpp>     // MuMiniZinc::detail::ExecutionJob, MuMiniZinc::detail::Progress
+#include <executor/process.hpp> // MuMiniZinc::detail::JobSlots
+
+/**
+ * @file
+ * @brief The scheduler that launches the executions of a run and handles their processes.
+ */
+namespace MuMiniZinc::detail
+{
+
+/** The size of the buffers the standard output of the executions is read into. */
+constexpr std::size_t read_buffer_size { 64 * 1024 };
+
+/** Buffers for reading the output of the executions, kept around so every execution does not allocate its own. */
+class BufferPool
+{
+public:
+    using Buffer = std::unique_ptr<std::array<char, read_buffer_size>>;
+
+    [[nodiscard]] Buffer acquire();
+
+    void release(Buffer buffer);
+
+private:
+    std::vector<Buffer> m_buffers;
+};
+
+/**
+ * Launches the jobs of a queue, keeping at most `max_jobs` of them running at the same time, each of them
+ * holding one slot of JobSlots or more.
+ *
+ * Both pipes of every process are read while it runs. The standard output is compared with the expected
+ * output while it is read, or captured, and the process is stopped as soon as it diverges or exceeds its
+ * limits. The options of MuMiniZinc::execution_args document how they change the executions.
+ *
+ * The state of the scheduler, the progress and the results are only touched from a strand, while every
+ * execution has a strand of its own, so several threads can run the handlers of the context. The handlers
+ * do not throw: an error stops the run like an interruption, and run throws it once every process has exited.
+ *
+ * Jobs of type StageJob bring their own arguments and are not counted in the progress.
+ */
+template<ExecutionJob Job>
+class Scheduler
+{
+public:
+    /**
+     * @param ctx the context the executions are handled by.
+     * @param parameters the options of the run.
+     * @param arguments the arguments of the compiler, whose first one is replaced by the model and last one by the data file of every job.
+     * @param jobs the queue of jobs, which the callbacks of StageJob may add to.
+     * @param max_jobs the amount of job slots.
+     * @param progress the progress of the run.
+     * @param scratch_directory where every process gets a directory of its own as `TMPDIR`, or `nullptr`.
+     * @param interrupted the flag set by SIGINT and SIGTERM while run runs, shared by the schedulers of a run, or `nullptr`.
+     */
+    Scheduler(boost::asio::io_context& ctx, const MuMiniZinc::execution_args& parameters, std::span<boost::string_view> arguments, std::deque<Job>& jobs, std::uint64_t max_jobs, Progress& progress, const ScratchDirectory* scratch_directory = nullptr, std::atomic<bool>* interrupted = nullptr);
+
+    /**
+     * Runs all the jobs, handling the executions on several threads.
+     *
+     * @param n_threads the amount of threads, including this one.
+     *
+     * @throws std::exception the first error of the run, once every process it has launched has exited.
+     */
+    void run(std::uint64_t n_threads);
+
+private:
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    /**
+     * The state of a running job, shared by the handlers of its asynchronous operations. Its I/O objects
+     * use its strand, so their handlers never run concurrently. Once its process has exited and its pipes
+     * are closed, finish hands it over to the strand of the scheduler, and its strand does not touch it again.
+     */
+    struct Execution;
+
+    boost::asio::io_context& m_ctx;
+    const MuMiniZinc::execution_args& m_parameters;
+    std::span<boost::string_view> m_arguments;
+    std::deque<Job>& m_jobs;
+
+    std::uint64_t m_max_jobs;
+    std::uint64_t m_limit;
+    std::uint64_t m_running {};
+    std::uint64_t m_failed_spawns {};
+
+    Progress& m_progress;
+
+    Strand m_strand;
+    boost::asio::steady_timer m_retry_timer;
+    BufferPool m_buffers;
+
+    static constexpr std::string_view temporary_directory_variable { "TMPDIR" };
+
+    const ScratchDirectory* m_scratch_directory;
+    std::vector<boost::process::environment::key_value_pair> m_environment;
+    std::uint64_t m_launched {};
+
+    std::uint64_t m_solver_threads;
+    JobSlots m_slots;
+
+    std::atomic<bool>* m_interrupted;
+    std::optional<boost::asio::signal_set> m_signals;
+    std::vector<std::shared_ptr<Execution>> m_executions;
+
+    /** The first error of the run, which is thrown by run once everything has stopped. */
+    std::exception_ptr m_error;
+
+    /** Launches jobs until the admission limit is reached or there are no jobs left. */
+    void fill();
+
+    /**
+     * Stops the run on an error, instead of throwing it from a handler: the queued jobs are dropped and
+     * the running processes are stopped, without recording their results.
+     */
+    void fail(std::exception_ptr error);
+
+    /** Stops the run on an interruption signal: the queued jobs are dropped and the running processes are stopped. */
+    void interrupt();
+
+    /** Records the queued jobs as interrupted, without launching them. */
+    void drop_jobs();
+
+    /**
+     * Handles a spawn that has failed because the system has run out of resources (EMFILE, ENFILE or
+     * EAGAIN): the admission limit is lowered to the amount of running processes, and grows back by one
+     * every time a process finishes.
+     */
+    void back_off();
+
+    /** The output the job's output is compared with, or `nullptr` if its output must be captured. */
+    [[nodiscard]] static const std::string* get_expected_output(const Job& job) noexcept;
+
+    bool launch();
+
+    /**
+     * Returns the arguments of the launcher with its placeholders replaced, followed by the compiler and
+     * its arguments. `{slot}` is the first slot of the execution, `{cpu}` the list of the CPUs of its slots,
+     * from JobSlots, and `{job}` the number of the execution.
+     */
+    template<typename Arguments>
+    [[nodiscard]] std::vector<std::string> get_launcher_arguments(const Execution& execution, const Arguments& arguments) const;
+
+    /** Starts the asynchronous operations of an execution, from its strand. */
+    void start(const std::shared_ptr<Execution>& execution);
+
+#if defined(__linux__) && defined(BOOST_PROCESS_V2_PIDFD_OPEN)
+    /**
+     * Waits for the process through the pidfd of its handle, and reaps it with `wait4` instead of letting
+     * the handle do it, to get its CPU time and peak memory. The handle is then detached, so it neither
+     * waits for the process again nor stops it when destroyed, as its pid may have been reused.
+     *
+     * @return whether the wait has been started, which fails if the handle has no pidfd, like when the kernel does not support them.
+     */
+    bool wait_with_usage(const std::shared_ptr<Execution>& execution);
+#endif
+
+    /**
+     * Stops the process if it is still running a while after the time limit given to the compiler, in
+     * case the compiler or the solver does not honor it.
+     */
+    void enforce_time_limit(const std::shared_ptr<Execution>& execution);
+
+    void on_process_exit(const std::shared_ptr<Execution>& execution, boost::system::error_code ec, int exit_code);
+
+    static void close_pipes(Execution& execution);
+
+    void write_input(const std::shared_ptr<Execution>& execution);
+
+    void read_output(std::shared_ptr<Execution> execution);
+
+    void read_error(std::shared_ptr<Execution> execution);
+
+    /** Appends as much of a chunk as allowed by a limit of bytes (zero meaning no limit), and returns whether it all fit. */
+    static bool append_limited(std::string& output, std::string_view chunk, std::uint64_t limit);
+
+    /**
+     * Splits a chunk of the standard output in lines, if the statistics are being removed from it, and
+     * consumes them. Otherwise, the chunk is consumed as it is.
+     */
+    void consume_lines(const std::shared_ptr<Execution>& execution, std::string_view chunk);
+
+    /** Stores a line of statistics, or consumes any other line. */
+    void consume_line(const std::shared_ptr<Execution>& execution, std::string_view line);
+
+    /** Compares or captures a chunk of the standard output. */
+    void consume(const std::shared_ptr<Execution>& execution, std::string_view chunk);
+
+    /** Appends a chunk to the end of the output of a diverged execution, keeping its last `divergence_tail_size` bytes. */
+    static void append_tail(Execution& execution, std::string_view chunk);
+
+    /** Asks a process to exit, and kills it if it is still running after the grace period. */
+    static void stop(const std::shared_ptr<Execution>& execution);
+
+    /** Completes a job once its process has exited, its input has been written and both of its output pipes have been read. */
+    void finish(const std::shared_ptr<Execution>& execution);
+
+    /** Records the result of a finished job and launches more, from the strand of the scheduler. */
+    void complete(Execution& execution);
+
+    static void remove_temporary_directory(Execution& execution);
+
+    /**
+     * Checks whether a failed execution has failed because of its limits: it has written too much output,
+     * it has been killed at its CPU time limit, or it has reported that it could not allocate memory under
+     * its memory limit.
+     *
+     * Every process gets its own CPU time limit. The one that reaches it gets `SIGXCPU`, and `SIGKILL` a
+     * second later if it is still running, so the signal that has terminated the process decides, unless
+     * the `SIGKILL` comes from stopping it. A process it has started, like the solver, may hit the limit
+     * instead, which is reported in the error output with the description of `SIGXCPU`.
+     */
+    [[nodiscard]] bool has_exceeded_limits(const Execution& execution) const;
+
+    void on_exit(Execution& execution);
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
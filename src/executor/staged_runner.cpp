@@ -0,0 +1,340 @@
+#include <executor/staged_runner.hpp>
+
+#include <format>       // std::format
+#include <optional>     // std::nullopt
+#include <system_error> // std::error_code
+#include <utility>      // std::move
+
+#include <muminizinc/delta.hpp>    // MuMiniZinc::detail::find_mutated_item, MuMiniZinc::detail::get_item_kind, MuMiniZinc::detail::MutatedItem, MuMiniZinc::detail::split_items, MuMiniZinc::find_variable_declarations, MuMiniZinc::FlattenedItem, MuMiniZinc::replace_flattened_item
+#include <muminizinc/logging.hpp>  // logging::path_to_utf8
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+#include <executor/files.hpp> // MuMiniZinc::detail::read_file, MuMiniZinc::detail::write_file
+#include <executor/job.hpp>   // MuMiniZinc::detail::complete_job, MuMiniZinc::detail::MutantJob, MuMiniZinc::detail::OriginalJob, MuMiniZinc::detail::record_result
+
+namespace MuMiniZinc::detail
+{
+
+StagedRunner::StagedRunner(const MuMiniZinc::execution_args& parameters, std::span<std::string> original_outputs, std::span<MuMiniZinc::Entry::Usage> original_usages, std::string_view time_limit, Progress& progress, Journal* journal) :
+    m_parameters { parameters }, m_original_outputs { original_outputs }, m_original_usages { original_usages }, m_data_files { original_outputs.size() }, m_progress { progress }, m_journal { journal }, m_is_delta { parameters.engine == MuMiniZinc::ExecutionEngine::Delta }, m_directory { parameters.shared_files }
+{
+    for (const auto argument : parameters.compiler_arguments)
+        m_compiler_arguments.emplace_back(argument);
+
+    m_solver_arguments = m_compiler_arguments;
+
+    if (parameters.statistics)
+        m_solver_arguments.emplace_back("--statistics");
+
+    if (!time_limit.empty())
+    {
+        m_solver_arguments.emplace_back("--time-limit");
+        m_solver_arguments.emplace_back(time_limit);
+    }
+
+    write_file(original_path(), parameters.normalized_model);
+
+    if (!m_is_delta)
+        return;
+
+    const auto items = split_items(parameters.normalized_model);
+
+    for (const auto item : items)
+    {
+        if (get_item_kind(item) != MutatedItem::Kind::Constraint)
+            m_declarations_model.append(item).append(";\n");
+    }
+
+    m_variables = MuMiniZinc::find_variable_declarations(items);
+
+    write_file(declarations_path(), m_declarations_model);
+}
+
+void StagedRunner::queue_originals(std::deque<StageJob>& jobs)
+{
+    for (std::size_t index {}; index < m_data_files.size(); ++index)
+    {
+        auto& data_file = m_data_files[index];
+
+        data_file.output_path = m_directory.path() / std::format("original-{:d}.ozn", index);
+
+        if (m_parameters.reuse_original_solutions)
+            jobs.push_back(original_compilation_job(jobs, index));
+        else
+        {
+            jobs.push_back(original_job(index));
+
+            if (m_is_delta)
+                jobs.push_back(original_compilation_job(jobs, index));
+        }
+
+        if (!m_is_delta)
+            continue;
+
+        const auto declarations_fzn = m_directory.path() / std::format("declarations-{:d}.fzn", index);
+
+        // If it fails, the mutants will be flattened as usual with this data file.
+        jobs.emplace_back(compile_arguments(logging::path_to_utf8(declarations_path()), declarations_fzn, std::nullopt, index), std::string_view {}, [&data_file, declarations_fzn](ExecutionResult result)
+            {
+                if (result.success)
+                    data_file.declarations.emplace(read_file(declarations_fzn));
+
+                std::error_code error_code;
+                std::filesystem::remove(declarations_fzn, error_code); });
+    }
+}
+
+void StagedRunner::queue_mutant(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant)
+{
+    // Without the position of its mutation, the mutant is run as usual.
+    const auto item = mutant.mutated_item.has_value() ? find_mutated_item(m_parameters.normalized_model, mutant.contents, *mutant.mutated_item) : std::nullopt;
+
+    const auto is_output = item.has_value() && item->kind == MutatedItem::Kind::Output && m_parameters.reuse_original_solutions;
+
+    std::shared_ptr<const DeltaModel> delta_model;
+
+    if (m_is_delta && item.has_value() && item->kind == MutatedItem::Kind::Constraint)
+    {
+        auto contents = m_declarations_model;
+        const auto item_offset = contents.size();
+        contents.append(item->mutated).append(";\n");
+
+        const auto path = m_directory.path() / std::format("mutant-{:d}.mzn", m_mutant_count++);
+        write_file(path, contents);
+
+        delta_model = std::make_shared<const DeltaModel>(logging::path_to_utf8(path), std::move(contents), item_offset, item->mutated.size(), item->original);
+    }
+
+    for (std::size_t index {}; index < m_data_files.size(); ++index)
+    {
+        const auto& data_file = m_data_files[index];
+
+        if (is_output && data_file.solutions.has_value())
+            jobs.push_back(output_job(jobs, mutant, index));
+        else if (delta_model != nullptr && data_file.original.has_value() && data_file.declarations.has_value())
+            jobs.push_back(delta_job(jobs, mutant, delta_model, index));
+        else
+            jobs.push_back(full_job(mutant, index));
+    }
+}
+
+[[nodiscard]] std::filesystem::path StagedRunner::job_path(std::string_view extension)
+{
+    return m_directory.path() / std::format("job-{:d}.{:s}", m_job_count++, extension);
+}
+
+[[nodiscard]] std::string_view StagedRunner::data_file(std::size_t index) const noexcept
+{
+    return m_parameters.data_files.empty() ? std::string_view {} : std::string_view { m_parameters.data_files[index] };
+}
+
+[[nodiscard]] std::vector<std::string> StagedRunner::compile_arguments(std::string_view model, const std::filesystem::path& flatzinc, const std::optional<std::filesystem::path>& output, std::size_t index) const
+{
+    auto arguments = m_compiler_arguments;
+
+    arguments.emplace_back("-c");
+
+    if (m_is_delta)
+        arguments.emplace_back("--keep-paths");
+
+    arguments.emplace_back("--fzn");
+    arguments.emplace_back(logging::path_to_utf8(flatzinc));
+
+    if (output.has_value())
+    {
+        arguments.emplace_back("--ozn");
+        arguments.emplace_back(logging::path_to_utf8(*output));
+    }
+    else
+        arguments.emplace_back("--no-output-ozn");
+
+    arguments.emplace_back(model);
+
+    if (const auto data = data_file(index); !data.empty())
+        arguments.emplace_back(data);
+
+    return arguments;
+}
+
+[[nodiscard]] std::vector<std::string> StagedRunner::output_arguments(const std::filesystem::path& output) const
+{
+    auto arguments = m_compiler_arguments;
+
+    arguments.emplace_back("--ozn-file");
+    arguments.emplace_back(logging::path_to_utf8(output));
+
+    return arguments;
+}
+
+void StagedRunner::record_original(std::size_t index, ExecutionResult result)
+{
+    m_progress.advance();
+
+    OriginalJob job { m_parameters.normalized_model, data_file(index), m_original_outputs[index], {}, &m_original_usages[index] };
+    record_result(job, std::move(result), m_progress);
+}
+
+void StagedRunner::record(MuMiniZinc::Entry& mutant, std::size_t index, ExecutionResult result)
+{
+    m_progress.advance();
+
+    MutantJob job { mutant.contents, data_file(index), &m_original_outputs[index], &mutant.results[index], mutant.results, {}, &mutant.usages[index], m_journal, index };
+    complete_job(job, std::move(result), m_progress);
+}
+
+[[nodiscard]] StageJob StagedRunner::original_job(std::size_t index)
+{
+    auto arguments = m_solver_arguments;
+    arguments.emplace_back("-");
+
+    if (const auto data = data_file(index); !data.empty())
+        arguments.emplace_back(data);
+
+    return { std::move(arguments), m_parameters.normalized_model, [this, index](ExecutionResult result)
+        { record_original(index, std::move(result)); } };
+}
+
+[[nodiscard]] StageJob StagedRunner::original_compilation_job(std::deque<StageJob>& jobs, std::size_t index)
+{
+    auto flatzinc = m_directory.path() / std::format("original-{:d}.fzn", index);
+    auto arguments = compile_arguments(logging::path_to_utf8(original_path()), flatzinc, m_data_files[index].output_path, index);
+
+    return { std::move(arguments), std::string_view {}, [this, &jobs, flatzinc = std::move(flatzinc), index](ExecutionResult result)
+        {
+            auto& data_file = m_data_files[index];
+
+            if (!m_parameters.reuse_original_solutions)
+            {
+                // The original model is run as usual, so the mutants will be flattened as usual with this data file.
+                if (result.success)
+                    data_file.original.emplace(read_file(flatzinc));
+
+                std::error_code error_code;
+                std::filesystem::remove(flatzinc, error_code);
+
+                return;
+            }
+
+            if (!result.success)
+            {
+                record_original(index, std::move(result));
+                return;
+            }
+
+            if (m_is_delta)
+                data_file.original.emplace(read_file(flatzinc));
+
+            auto arguments = m_solver_arguments;
+            arguments.emplace_back(logging::path_to_utf8(flatzinc));
+
+            jobs.emplace_front(std::move(arguments), std::string_view {}, [this, &jobs, &data_file, flatzinc, index](ExecutionResult result)
+                {
+                    std::error_code error_code;
+                    std::filesystem::remove(flatzinc, error_code);
+
+                    if (!result.success)
+                    {
+                        record_original(index, std::move(result));
+                        return;
+                    }
+
+                    data_file.solutions = std::move(result.output);
+
+                    jobs.emplace_front(output_arguments(data_file.output_path), *data_file.solutions, [this, index](ExecutionResult result)
+                        { record_original(index, std::move(result)); }); }); } };
+}
+
+[[nodiscard]] StageJob StagedRunner::full_job(MuMiniZinc::Entry& mutant, std::size_t index)
+{
+    auto arguments = m_solver_arguments;
+    arguments.emplace_back("-");
+
+    if (const auto data = data_file(index); !data.empty())
+        arguments.emplace_back(data);
+
+    return { std::move(arguments), mutant.contents, [this, &mutant, index](ExecutionResult result)
+        { record(mutant, index, std::move(result)); }, &m_original_outputs[index], &mutant.results[index] };
+}
+
+[[nodiscard]] StageJob StagedRunner::output_job(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant, std::size_t index)
+{
+    auto flatzinc = job_path("fzn");
+    auto output = job_path("ozn");
+
+    // The FlatZinc is only written because the compiler needs a destination for it.
+    auto arguments = compile_arguments("-", flatzinc, output, index);
+
+    return { std::move(arguments), mutant.contents, [this, &jobs, &mutant, flatzinc = std::move(flatzinc), output = std::move(output), index](ExecutionResult result)
+        {
+            std::error_code error_code;
+            std::filesystem::remove(flatzinc, error_code);
+
+            if (!result.success)
+            {
+                std::filesystem::remove(output, error_code);
+                jobs.push_front(full_job(mutant, index));
+                return;
+            }
+
+            jobs.emplace_front(output_arguments(output), *m_data_files[index].solutions, [this, &jobs, &mutant, output, index](ExecutionResult result)
+                {
+                    std::error_code error_code;
+                    std::filesystem::remove(output, error_code);
+
+                    // The output specification may need something the original's solutions do not have.
+                    if (!result.success)
+                    {
+                        jobs.push_front(full_job(mutant, index));
+                        return;
+                    }
+
+                    record(mutant, index, std::move(result)); }, &m_original_outputs[index]); }, nullptr, &mutant.results[index] };
+}
+
+[[nodiscard]] StageJob StagedRunner::delta_job(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant, std::shared_ptr<const DeltaModel> delta_model, std::size_t index)
+{
+    auto flatzinc = job_path("fzn");
+    auto arguments = compile_arguments(delta_model->path, flatzinc, std::nullopt, index);
+
+    return { std::move(arguments), std::string_view {}, [this, &jobs, &mutant, delta_model = std::move(delta_model), flatzinc = std::move(flatzinc), index](ExecutionResult result)
+        {
+            std::optional<std::string> merged;
+
+            if (result.success)
+            {
+                const auto& data_file = m_data_files[index];
+                const MuMiniZinc::FlatModel mutated { read_file(flatzinc) };
+                const auto original_file = logging::path_to_utf8(original_path());
+
+                const MuMiniZinc::FlattenedItem original_item { .flat_model = *data_file.original, .file = original_file, .model = m_parameters.normalized_model, .item = delta_model->original_item };
+                const MuMiniZinc::FlattenedItem mutated_item { .flat_model = mutated, .file = delta_model->path, .model = delta_model->contents, .item = std::string_view { delta_model->contents }.substr(delta_model->item_offset, delta_model->item_size) };
+
+                merged = MuMiniZinc::replace_flattened_item(original_item, mutated_item, *data_file.declarations, m_variables);
+            }
+
+            // The mutated item could not be compiled on its own or changes the domains, so flatten the whole mutant.
+            if (!merged.has_value())
+            {
+                std::error_code error_code;
+                std::filesystem::remove(flatzinc, error_code);
+
+                jobs.push_front(full_job(mutant, index));
+                return;
+            }
+
+            write_file(flatzinc, *merged);
+
+            auto arguments = m_solver_arguments;
+            arguments.emplace_back(logging::path_to_utf8(flatzinc));
+            arguments.emplace_back("--ozn-file");
+            arguments.emplace_back(logging::path_to_utf8(m_data_files[index].output_path));
+
+            jobs.emplace_front(std::move(arguments), std::string_view {}, [this, &mutant, flatzinc, index](ExecutionResult result)
+                {
+                    std::error_code error_code;
+                    std::filesystem::remove(flatzinc, error_code);
+
+                    record(mutant, index, std::move(result)); }, &m_original_outputs[index]); }, nullptr, &mutant.results[index] };
+}
+
+} // namespace MuMiniZinc::detail
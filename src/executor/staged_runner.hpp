@@ -0,0 +1,140 @@
+#ifndef EXECUTOR_STAGED_RUNNER_HPP
+#define EXECUTOR_STAGED_RUNNER_HPP
+
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint64_t
+#include <deque>       // std::deque
+#include <filesystem>  // std::filesystem::path
+#include <memory>      // std::shared_ptr
+#include <optional>    // std::optional
+#include <span>        // std::span
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+#include <muminizinc/delta.hpp>    // MuMiniZinc::FlatModel
+#include <muminizinc/executor.hpp> // MuMiniZinc::execution_args
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry
+
+#include <executor/files.hpp> // MuMiniZinc::detail::ScratchDirectory
+#include <executor/job.hpp>   // MuMiniZinc::detail::ExecutionResult, MuMiniZinc::detail::Progress, MuMiniZinc::detail::StageJob
+
+/**
+ * @file
+ * @brief The executions that run the models in several stages, for the delta engine and for reusing the solutions of the original model.
+ */
+namespace MuMiniZinc::detail
+{
+
+class Journal;
+
+/**
+ * Runs the models in several stages, through files in a scratch directory. Used by
+ * MuMiniZinc::ExecutionEngine::Delta and by MuMiniZinc::execution_args::reuse_original_solutions.
+ *
+ * With the delta engine, the original model and its declarations (every item but the constraints) are
+ * compiled once per data file. Every mutant that changes a constraint item gets its item compiled along
+ * with the declarations, and the result replaces the constraints of the original item in the FlatZinc
+ * of the original model.
+ *
+ * When reusing the original's solutions, the original model is compiled, solved and its solutions are
+ * formatted in separate stages. Every mutant that changes an output item is only compiled, and the
+ * solutions of the original model are formatted with its output specification.
+ *
+ * The rest of the mutants are run as usual.
+ */
+class StagedRunner
+{
+public:
+    /**
+     * Writes the models the stages share to a new scratch directory.
+     *
+     * @param parameters the options of the run.
+     * @param original_outputs where to store the output of the original model with every data file.
+     * @param original_usages where to store the resources used by the original model with every data file.
+     * @param time_limit the value of `--time-limit` for the solver, or empty for no limit.
+     * @param progress the progress of the run.
+     * @param journal where to record the executions of the mutants, or `nullptr`.
+     */
+    StagedRunner(const MuMiniZinc::execution_args& parameters, std::span<std::string> original_outputs, std::span<MuMiniZinc::Entry::Usage> original_usages, std::string_view time_limit, Progress& progress, Journal* journal);
+
+    /** Queues the executions of the original model with every data file, and the compilations they need. */
+    void queue_originals(std::deque<StageJob>& jobs);
+
+    /** Queues the execution of a mutant with every data file. */
+    void queue_mutant(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant);
+
+private:
+    struct DataFile
+    {
+        std::optional<MuMiniZinc::FlatModel> original;
+        std::optional<MuMiniZinc::FlatModel> declarations;
+        std::optional<std::string> solutions;
+        std::filesystem::path output_path;
+    };
+
+    struct DeltaModel
+    {
+        std::string path;
+        std::string contents;
+        std::size_t item_offset;
+        std::size_t item_size;
+        std::string_view original_item;
+    };
+
+    const MuMiniZinc::execution_args& m_parameters;
+    std::span<std::string> m_original_outputs;
+    std::span<MuMiniZinc::Entry::Usage> m_original_usages;
+    std::vector<DataFile> m_data_files;
+    Progress& m_progress;
+    Journal* m_journal;
+    bool m_is_delta;
+
+    ScratchDirectory m_directory;
+    std::vector<std::string> m_compiler_arguments;
+    std::vector<std::string> m_solver_arguments;
+    std::string m_declarations_model;
+    std::vector<std::string_view> m_variables;
+    std::uint64_t m_mutant_count {};
+    std::uint64_t m_job_count {};
+
+    [[nodiscard]] std::filesystem::path original_path() const { return m_directory.path() / "original.mzn"; }
+    [[nodiscard]] std::filesystem::path declarations_path() const { return m_directory.path() / "declarations.mzn"; }
+
+    [[nodiscard]] std::filesystem::path job_path(std::string_view extension);
+
+    [[nodiscard]] std::string_view data_file(std::size_t index) const noexcept;
+
+    /** Arguments for compiling a model, with `--keep-paths` for the delta engine. */
+    [[nodiscard]] std::vector<std::string> compile_arguments(std::string_view model, const std::filesystem::path& flatzinc, const std::optional<std::filesystem::path>& output, std::size_t index) const;
+
+    /** Arguments for formatting a stream of solutions with the given output specification, read from the standard input. */
+    [[nodiscard]] std::vector<std::string> output_arguments(const std::filesystem::path& output) const;
+
+    void record_original(std::size_t index, ExecutionResult result);
+
+    /** Records the result of a mutant with a data file, marking it as invalid with all of them if the model itself has failed. */
+    void record(MuMiniZinc::Entry& mutant, std::size_t index, ExecutionResult result);
+
+    /** An execution that flattens and solves the whole original model. */
+    [[nodiscard]] StageJob original_job(std::size_t index);
+
+    /**
+     * Compiles the original model. With the delta engine, its FlatZinc is kept for the mutants. When reusing
+     * the solutions, the FlatZinc is then solved and the solutions are formatted.
+     */
+    [[nodiscard]] StageJob original_compilation_job(std::deque<StageJob>& jobs, std::size_t index);
+
+    /** An execution that flattens the whole mutant. */
+    [[nodiscard]] StageJob full_job(MuMiniZinc::Entry& mutant, std::size_t index);
+
+    /** An execution that compiles an output mutant and formats the solutions of the original model with it. */
+    [[nodiscard]] StageJob output_job(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant, std::size_t index);
+
+    /** An execution that compiles the mutated item and, if possible, solves it from the FlatZinc of the original model. */
+    [[nodiscard]] StageJob delta_job(std::deque<StageJob>& jobs, MuMiniZinc::Entry& mutant, std::shared_ptr<const DeltaModel> delta_model, std::size_t index);
+};
+
+} // namespace MuMiniZinc::detail
+
+#endif
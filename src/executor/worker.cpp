@@ -0,0 +1,131 @@
+#include <muminizinc/executor.hpp>
+
+#include <chrono>        // std::chrono::seconds
+#include <cstdint>       // std::int64_t, std::uint64_t
+#include <deque>         // std::deque
+#include <format>        // std::format
+#include <istream>       // std::istream
+#include <optional>      // std::optional
+#include <ostream>       // std::endl, std::ostream
+#include <string>        // std::getline, std::string
+#include <unordered_map> // std::unordered_map
+#include <utility>       // std::move
+#include <vector>        // std::vector
+
+#include <boost/asio/io_context.hpp> // boost::asio::io_context
+
+#include <nlohmann/json.hpp> // nlohmann::json
+
+#include <muminizinc/logging.hpp> // logging::output
+
+#include <executor/coordinator.hpp> // MuMiniZinc::detail::get_usage_json
+#include <executor/job.hpp>         // MuMiniZinc::detail::ExecutionResult, MuMiniZinc::detail::Progress, MuMiniZinc::detail::StageJob
+#include <executor/scheduler.hpp>   // MuMiniZinc::detail::Scheduler
+
+namespace MuMiniZinc
+{
+
+void run_worker(const worker_args& parameters)
+{
+    boost::asio::io_context ctx;
+    detail::Progress progress { 0, logging::output {} };
+
+    // The expected outputs are only sent with the first job that needs them, and kept by their numbers.
+    std::unordered_map<std::uint64_t, std::string> expected_outputs;
+
+    std::string line;
+
+    while (std::getline(parameters.input, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::uint64_t id {};
+        std::string model;
+        const std::string* expected_output {};
+        std::vector<std::string> arguments { "-" };
+        std::chrono::seconds timeout {};
+        std::uint64_t max_output_size {};
+        std::uint64_t max_error_size {};
+        std::uint64_t memory_limit {};
+        std::chrono::seconds cpu_time_limit {};
+        bool statistics {};
+
+        try
+        {
+            const auto request = nlohmann::json::parse(line);
+
+            id = request.at("id").get<std::uint64_t>();
+            model = request.at("model").get<std::string>();
+            timeout = std::chrono::seconds { request.at("timeout").get<std::int64_t>() };
+            max_output_size = request.at("max_output_size").get<std::uint64_t>();
+            max_error_size = request.at("max_error_size").get<std::uint64_t>();
+            memory_limit = request.at("memory_limit").get<std::uint64_t>();
+            cpu_time_limit = std::chrono::seconds { request.at("cpu_time_limit").get<std::int64_t>() };
+            statistics = request.at("statistics").get<bool>();
+
+            for (const auto& argument : request.at("arguments"))
+                arguments.push_back(argument.get<std::string>());
+
+            if (const auto data_file = request.find("data_file"); data_file != request.end())
+                arguments.push_back(data_file->get<std::string>());
+
+            if (const auto expected_id = request.find("expected_id"); expected_id != request.end())
+            {
+                const auto number = expected_id->get<std::uint64_t>();
+
+                if (const auto expected = request.find("expected"); expected != request.end())
+                    expected_outputs.insert_or_assign(number, expected->get<std::string>());
+
+                const auto found = expected_outputs.find(number);
+
+                if (found == expected_outputs.end())
+                    throw ExecutionError { std::format("The job refers to an expected output that has not been sent:\n{:s}", line) };
+
+                expected_output = &found->second;
+            }
+        }
+        catch (const nlohmann::json::exception&)
+        {
+            throw ExecutionError { std::format("Could not parse the job:\n{:s}", line) };
+        }
+
+        const execution_args job_parameters {
+            .compiler_path = parameters.compiler_path,
+            .timeout = timeout,
+            .max_output_size = max_output_size,
+            .max_error_size = max_error_size,
+            .use_vfork = parameters.use_vfork,
+            .statistics = statistics,
+            .launcher = parameters.launcher,
+            .memory_limit = memory_limit,
+            .cpu_time_limit = cpu_time_limit
+        };
+
+        std::optional<detail::ExecutionResult> result;
+
+        std::deque<detail::StageJob> jobs;
+        jobs.emplace_back(std::move(arguments), model, [&result](detail::ExecutionResult execution_result)
+            { result = std::move(execution_result); }, expected_output);
+
+        detail::Scheduler scheduler { ctx, job_parameters, {}, jobs, 1, progress };
+        scheduler.run(1);
+
+        // The process could not be waited for.
+        if (!result.has_value())
+            result = detail::ExecutionResult { .output = "Cannot wait for the executable." };
+
+        const auto response = nlohmann::json::object({ { "id", id },
+            { "success", result->success },
+            { "output", std::move(result->output) },
+            { "matches", result->matches.has_value() ? nlohmann::json(*result->matches) : nlohmann::json(nullptr) },
+            { "timed_out", result->timed_out },
+            { "limit_exceeded", result->limit_exceeded },
+            { "exit_code", result->exit_code.has_value() ? nlohmann::json(*result->exit_code) : nlohmann::json(nullptr) },
+            { "usage", detail::get_usage_json(result->usage) } });
+
+        parameters.output << response.dump() << std::endl;
+    }
+}
+
+} // namespace MuMiniZinc
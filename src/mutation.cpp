@@ -1,7 +1,8 @@
 #include <muminizinc/mutation.hpp>
 
-#include <algorithm>    // std::ranges::contains, std::ranges::find_if
+#include <algorithm>    // std::max, std::min, std::ranges::contains, std::ranges::find_if
 #include <array>        // std::array
+#include <charconv>     // std::from_chars
 #include <cstddef>      // std::size_t
 #include <cstdint>      // std::uint64_t
 #include <filesystem>   // std::filesystem::absolute, std::filesystem::create_directory, std::filesystem::directory_iterator, std::filesystem::is_directory, std::filesystem::is_regular_file, std::filesystem::path, std::filesystem::remove_all
@@ -10,12 +11,13 @@
 #include <functional>   // std::reference_wrapper
 #include <iostream>     // std::cerr
 #include <iterator>     // std::distance
+#include <optional>     // std::optional
 #include <span>         // std::span
 #include <sstream>      // std::ostringstream
 #include <stdexcept>    // std::runtime_error
 #include <string>       // std::string
 #include <string_view>  // std::string_view
-#include <system_error> // std::error_code
+#include <system_error> // std::errc, std::error_code
 #include <type_traits>  // std::decay_t
 #include <utility>      // std::move, std::pair
 #include <variant>      // std::visit
@@ -45,6 +47,9 @@ constexpr auto WIDTH_PRINTER { 80 };
 constexpr auto SEPARATOR { '-' };
 constexpr auto enum_keyword { "enum "sv };
 
+/** Starts the first line of a dumped mutant, followed by the position of its mutated item. */
+constexpr auto mutated_item_comment { "% mutated item: "sv };
+
 constexpr bool is_quoted(std::string_view view) noexcept
 {
     std::uint64_t quotes {};
@@ -174,7 +179,7 @@ void throw_if_invalid_operators(std::span<const ascii_ci_string_view> allowed_op
 namespace MuMiniZinc
 {
 
-void EntryResult::save_model(const MiniZinc::Model* model, std::string_view operator_name, std::uint64_t location_id, std::uint64_t occurrence_id, std::span<const std::pair<std::string, std::string>> detected_enums)
+void EntryResult::save_model(const MiniZinc::Model* model, std::size_t item_index, std::string_view operator_name, std::uint64_t location_id, std::uint64_t occurrence_id, std::span<const std::pair<std::string, std::string>> detected_enums)
 {
     if (model == nullptr)
         throw std::runtime_error { "There is no model to print." };
@@ -199,7 +204,7 @@ void EntryResult::save_model(const MiniZinc::Model* model, std::string_view oper
     m_statistics[operator_id].second = std::max(m_statistics[operator_id].second, occurrence_id);
 
     auto mutant = std::format("{:s}{:c}{:s}{:c}{:d}{:c}{:d}", m_model_name, SEPARATOR, operator_name, SEPARATOR, location_id, SEPARATOR, occurrence_id);
-    m_mutants.emplace_back(std::move(mutant), std::move(output));
+    m_mutants.emplace_back(std::move(mutant), std::move(output)).mutated_item = item_index;
 }
 
 [[nodiscard]] std::filesystem::path get_path_from_model_path(const std::filesystem::path& model_path)
@@ -281,8 +286,11 @@ void EntryResult::save_model(const MiniZinc::Model* model, std::string_view oper
     {
         Mutator mutator { model, parameters.allowed_operators, entry_result, detected_enums };
 
-        for (const auto* const item : *model)
+        // Every item of the parsed model is printed as an item of the normalized model, in the same order.
+        for (std::size_t index {}; const auto* const item : *model)
         {
+            mutator.item_index(index++);
+
             if (const auto* constraintI = item->dynamicCast<MiniZinc::ConstraintI>())
                 MiniZinc::top_down(mutator, constraintI->e());
             else if (const auto* solveI = item->dynamicCast<MiniZinc::SolveI>(); solveI != nullptr && solveI->e() != nullptr)
@@ -359,9 +367,26 @@ void EntryResult::save_model(const MiniZinc::Model* model, std::string_view oper
             throw EmptyFile { std::format("The file `{:s}{:s}{:s}` is empty.", code(logging::Color::Blue), logging::path_to_utf8(entry.path()), code(logging::Style::Reset)) };
 
         if (is_normalized_model)
+        {
             entry_result.m_model_contents = std::move(str);
-        else
-            entry_result.m_mutants.emplace_back(std::move(stem), std::move(str));
+            continue;
+        }
+
+        // The position of the mutated item is only known if the mutant has been dumped with it.
+        std::optional<std::size_t> mutated_item;
+
+        if (str.starts_with(mutated_item_comment))
+        {
+            const auto line_end = std::min(str.find('\n'), str.size());
+            std::size_t index {};
+
+            if (const auto [end, error] = std::from_chars(str.data() + mutated_item_comment.size(), str.data() + line_end, index); error == std::errc {} && end == str.data() + line_end)
+                mutated_item = index;
+
+            str.erase(0, std::min(line_end + 1, str.size()));
+        }
+
+        entry_result.m_mutants.emplace_back(std::move(stem), std::move(str)).mutated_item = mutated_item;
     }
 
     return entry_result;
@@ -391,7 +416,11 @@ void dump_mutants(const EntryResult& entries, const std::filesystem::path& direc
     for (const auto& mutant : entries.mutants())
     {
         const auto path = (directory / mutant.name).replace_extension(EXTENSION);
-        dump_file(path, mutant.contents);
+
+        if (mutant.mutated_item.has_value())
+            dump_file(path, std::format("{:s}{:d}\n{:s}", mutated_item_comment, *mutant.mutated_item, mutant.contents));
+        else
+            dump_file(path, mutant.contents);
     }
 
     // Dump the normalized model.
@@ -404,17 +433,43 @@ void run_mutants(const run_mutants_args& parameters)
     if (parameters.entry_result.mutants().empty())
         return;
 
+    parameters.entry_result.m_original_usages.assign(std::max(parameters.data_files.size(), std::size_t { 1 }), {});
+
     const execution_args configuration {
         .compiler_path = parameters.compiler_path,
         .compiler_arguments = parameters.compiler_arguments,
         .data_files = parameters.data_files,
         .entries = parameters.entry_result.m_mutants,
+        .original_usages = parameters.entry_result.m_original_usages,
         .normalized_model = parameters.entry_result.normalized_model(),
         .timeout = parameters.timeout,
         .n_jobs = parameters.n_jobs,
         .allowed_mutants = parameters.allowed_mutants,
         .check_compiler_version = parameters.check_compiler_version,
-        .output_log = parameters.output_log
+        .output_log = parameters.output_log,
+        .engine = parameters.engine,
+        .reuse_original_solutions = parameters.reuse_original_solutions,
+        .max_output_size = parameters.max_output_size,
+        .max_error_size = parameters.max_error_size,
+        .shared_files = parameters.shared_files,
+        .scheduling = parameters.scheduling,
+        .boost_tail_threads = parameters.boost_tail_threads,
+        .use_vfork = parameters.use_vfork,
+        .io_threads = parameters.io_threads,
+        .statistics = parameters.statistics,
+        .cache_path = parameters.cache_path,
+        .golden_outputs_path = parameters.golden_outputs_path,
+        .write_golden_outputs_path = parameters.write_golden_outputs_path,
+        .journal_path = parameters.journal_path,
+        .resume = parameters.resume,
+        .handle_interrupts = parameters.handle_interrupts,
+        .shard_index = parameters.shard_index,
+        .shard_count = parameters.shard_count,
+        .worker_command = parameters.worker_command,
+        .launcher = parameters.launcher,
+        .pin_cpus = parameters.pin_cpus,
+        .memory_limit = parameters.memory_limit,
+        .cpu_time_limit = parameters.cpu_time_limit
     };
 
     execute_mutants(configuration);
@@ -167,7 +167,7 @@ void Mutator::perform_mutation(MiniZinc::BinOp* op, std::span<const MiniZinc::Bi
 
         logd("Mutating to {}", op->opToString().c_str());
 
-        m_entries.save_model(m_model, operator_name, m_location_counter, ++occurrence_id, m_detected_enums);
+        m_entries.save_model(m_model, m_item_index, operator_name, m_location_counter, ++occurrence_id, m_detected_enums);
     }
 
     // Go back to the original for the next iteration.
@@ -182,14 +182,14 @@ void Mutator::perform_mutation_unop(MiniZinc::BinOp* op)
     if (auto* unop = MiniZinc::Expression::dynamicCast<MiniZinc::UnOp>(lhs))
     {
         op->lhs(unop->e());
-        m_entries.save_model(m_model, unary_operators_name, m_location_counter, 1, m_detected_enums);
+        m_entries.save_model(m_model, m_item_index, unary_operators_name, m_location_counter, 1, m_detected_enums);
         op->lhs(lhs);
     }
 
     if (auto* unop = MiniZinc::Expression::dynamicCast<MiniZinc::UnOp>(rhs))
     {
         op->rhs(unop->e());
-        m_entries.save_model(m_model, unary_operators_name, m_location_counter, 1, m_detected_enums);
+        m_entries.save_model(m_model, m_item_index, unary_operators_name, m_location_counter, 1, m_detected_enums);
         op->rhs(rhs);
     }
 }
@@ -203,7 +203,7 @@ void Mutator::perform_mutation_unop(MiniZinc::Call* call)
         if (auto* unop = MiniZinc::Expression::dynamicCast<MiniZinc::UnOp>(original_element))
         {
             call->arg(i, unop->e());
-            m_entries.save_model(m_model, unary_operators_name, m_location_counter, 1, m_detected_enums);
+            m_entries.save_model(m_model, m_item_index, unary_operators_name, m_location_counter, 1, m_detected_enums);
             call->arg(i, original_element);
         }
     }
@@ -224,7 +224,7 @@ void Mutator::perform_mutation(MiniZinc::Call* call, std::span<const MiniZinc::A
 
         call->id(candidate_call);
 
-        m_entries.save_model(m_model, call_name, m_location_counter, ++occurrence_id, m_detected_enums);
+        m_entries.save_model(m_model, m_item_index, call_name, m_location_counter, ++occurrence_id, m_detected_enums);
     }
 
     call->id(original_call);
@@ -253,7 +253,7 @@ void Mutator::perform_call_swap_mutation(MiniZinc::Call* call)
 
         call->args(permutation);
 
-        m_entries.save_model(m_model, call_swap_name, m_location_counter, ++occurrence_id, m_detected_enums);
+        m_entries.save_model(m_model, m_item_index, call_swap_name, m_location_counter, ++occurrence_id, m_detected_enums);
 
     } while (std::ranges::next_permutation(permutation).found);
 
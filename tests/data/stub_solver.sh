@@ -0,0 +1,73 @@
+#!/bin/sh
+# Stands in for the MiniZinc compiler in the tests of the executor. It reads the model from the standard
+# input and behaves as its first word asks. Every execution is logged to `$STUB_SOLVER_LOG`, if it is set.
+
+if [ "$1" = "--version" ]; then
+    echo "MiniZinc to FlatZinc converter, version 0.0.0"
+    exit 0
+fi
+
+model=$(cat)
+
+if [ -n "$STUB_SOLVER_LOG" ]; then
+    echo "$model" >> "$STUB_SOLVER_LOG"
+fi
+
+case "$model" in
+    diverge*)
+        # The first line differs from the output of the original model, and the solver keeps running.
+        echo "x = 2;"
+        exec sleep 60
+        ;;
+    other*)
+        echo "x = 3;"
+        echo "----------"
+        ;;
+    unknown*)
+        # Reported by incomplete solvers too, so it is not a timeout by itself.
+        echo "=====UNKNOWN====="
+        ;;
+    timeout*)
+        # Written at once, so the report is not lost if the executor stops the stub once its output diverges.
+        printf '=====UNKNOWN=====\n%% Time limit exceeded\n'
+        ;;
+    hang*)
+        exec sleep 60
+        ;;
+    spin*)
+        while :; do :; done
+        ;;
+    oom*)
+        echo "std::bad_alloc" >&2
+        exit 1
+        ;;
+    typeerror*)
+        echo "model.mzn:1.1-9:" >&2
+        echo "Error: type error: undefined identifier \`typeerror'" >&2
+        exit 1
+        ;;
+    late-typeerror*)
+        # Only fails with the second data file, the last argument, after the first one has been run.
+        for data_file; do :; done
+
+        case "$data_file" in
+            *-2.dzn)
+                echo "model.mzn:1.1-14:" >&2
+                echo "Error: type error: undefined identifier \`typeerror'" >&2
+                exit 1
+                ;;
+            *)
+                echo "x = 1;"
+                echo "----------"
+                ;;
+        esac
+        ;;
+    error*)
+        echo "Error: the model cannot be run." >&2
+        exit 1
+        ;;
+    *)
+        echo "x = 1;"
+        echo "----------"
+        ;;
+esac
@@ -1,13 +1,246 @@
 #define BOOST_TEST_MODULE test_arguments
 #include <boost/test/included/unit_test.hpp>
 
-#include <array> // std::array
-#include <span>  // std::span
+#include <array>       // std::array
+#include <cstddef>     // std::size_t
+#include <cstdio>      // std::fclose, std::fflush, std::fread, std::rewind, std::tmpfile
+#include <filesystem>  // std::filesystem::path, std::filesystem::remove, std::filesystem::temp_directory_path
+#include <format>      // std::format
+#include <fstream>     // std::ofstream
+#include <iostream>    // std::cout
+#include <map>         // std::map
+#include <random>      // std::random_device
+#include <span>        // std::span
+#include <stdexcept>   // std::runtime_error
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+#include <nlohmann/json.hpp> // nlohmann::json
 
 #include <arguments.hpp> // BadArgument, parse_arguments
 
+#if defined(__unix__)
+#    include <stdio.h>  // fileno
+#    include <unistd.h> // close, dup, dup2, STDOUT_FILENO
+#endif
+
+namespace
+{
+
+/** A path in the temporary directory that no other run of the tests uses. */
+std::filesystem::path get_temporary_path(std::string_view name)
+{
+    return std::filesystem::temp_directory_path() / std::format("muminizinc-test-{:08x}-{:s}", std::random_device {}(), name);
+}
+
+#if defined(__unix__)
+/** Runs the program with the given arguments, and returns what it writes to the standard output. */
+std::string get_output(std::span<const char* const> arguments)
+{
+    std::cout.flush();
+    std::fflush(stdout);
+
+    auto* const file = std::tmpfile();
+    const auto saved_output = dup(STDOUT_FILENO);
+    dup2(fileno(file), STDOUT_FILENO);
+
+    const auto restore_output = [&]
+    {
+        std::cout.flush();
+        std::fflush(stdout);
+
+        dup2(saved_output, STDOUT_FILENO);
+        close(saved_output);
+    };
+
+    try
+    {
+        parse_arguments(arguments);
+    }
+    catch (...)
+    {
+        restore_output();
+        std::fclose(file);
+        throw;
+    }
+
+    restore_output();
+
+    std::string output;
+    std::array<char, 4096> buffer {};
+
+    std::rewind(file);
+
+    for (std::size_t size {}; (size = std::fread(buffer.data(), 1, buffer.size(), file)) > 0;)
+        output.append(buffer.data(), size);
+
+    std::fclose(file);
+
+    return output;
+}
+#endif
+
+/** Returns the results of every mutant from the JSON output of run, without the resources they used. */
+std::map<std::string, nlohmann::json> get_results(const nlohmann::json& output)
+{
+    std::map<std::string, nlohmann::json> results;
+
+    for (const auto& entry : output.at("results"))
+        results.emplace(entry.at("mutant").get<std::string>(), entry.at("results"));
+
+    return results;
+}
+
+} // namespace
+
 BOOST_AUTO_TEST_CASE(test_arguments)
 {
     BOOST_CHECK_NO_THROW(parse_arguments({}));
     BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "unknown_argument" }), BadArgument);
 }
+
+BOOST_AUTO_TEST_CASE(test_shard)
+{
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--shard", "0/2", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--shard", "3/2", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--shard", "1", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--shard", "a/2", "model.mzn" }), BadArgument);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge)
+{
+    const auto first_path = get_temporary_path("shard-1.json").string();
+    const auto second_path = get_temporary_path("shard-2.json").string();
+
+    std::ofstream { first_path } << R"({"results":[{"mutant":"model-ROR-10-0","results":[1,2]}],"summary":{},"slow":[]})";
+    std::ofstream { second_path } << R"({"results":[{"mutant":"model-ROR-2-0","results":[0,2]}],"summary":{},"slow":[]})";
+
+    BOOST_CHECK_NO_THROW(parse_arguments(std::array { "test", "merge", "--json", first_path.c_str(), second_path.c_str() }));
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "merge", first_path.c_str(), first_path.c_str() }), std::runtime_error);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "merge" }), BadArgument);
+
+#if defined(__unix__)
+    // The rows are those of the matrix of run, whose names are as wide as the name of the model plus ten characters.
+    const auto output = get_output(std::array { "test", "merge", first_path.c_str(), second_path.c_str() });
+    const auto expected_rows = std::format("{:<15}   0 2 \n{:<15}   1 2 \n", "model-ROR-2-0", "model-ROR-10-0");
+
+    BOOST_CHECK(output.starts_with(expected_rows));
+#endif
+
+    std::filesystem::remove(first_path);
+    std::filesystem::remove(second_path);
+}
+
+#if defined(__unix__)
+BOOST_AUTO_TEST_CASE(test_merge_shards)
+{
+    const auto run = [](std::string_view shard)
+    {
+        const std::string shard_argument { shard };
+
+        std::vector<const char*> arguments { "test", "run", "--in-memory", "--compiler-path", "data/stub_compiler.sh", "--ignore-version-check", "--json", "--data", "data/ror-1.dzn,data/ror-2.dzn" };
+
+        if (!shard.empty())
+        {
+            arguments.push_back("--shard");
+            arguments.push_back(shard_argument.c_str());
+        }
+
+        arguments.push_back("data/ror.mzn");
+
+        return get_output(arguments);
+    };
+
+    const auto unsharded = nlohmann::json::parse(run({}));
+    const auto first_output = run("1/2");
+    const auto second_output = run("2/2");
+
+    // The shard of a mutant only depends on its name.
+    BOOST_CHECK(get_results(nlohmann::json::parse(run("1/2"))) == get_results(nlohmann::json::parse(first_output)));
+
+    const auto first_path = get_temporary_path("shard-1.json").string();
+    const auto second_path = get_temporary_path("shard-2.json").string();
+
+    std::ofstream { first_path } << first_output;
+    std::ofstream { second_path } << second_output;
+
+    const auto merged = nlohmann::json::parse(get_output(std::array { "test", "merge", "--json", second_path.c_str(), first_path.c_str() }));
+
+    std::filesystem::remove(first_path);
+    std::filesystem::remove(second_path);
+
+    // Every mutant is in a single shard, with the same results as without shards.
+    BOOST_REQUIRE(merged.at("results").size() == unsharded.at("results").size());
+    BOOST_CHECK(merged.at("summary") == unsharded.at("summary"));
+
+    BOOST_CHECK(get_results(merged) == get_results(unsharded));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_worker)
+{
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "worker", "unknown_argument" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--worker-command", "muminizinc worker", "--engine", "in-process", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--worker-command", "muminizinc worker", "--pin-cpus", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--worker-command", "muminizinc worker", "--shared-files", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--worker-command", "muminizinc worker", "--journal", "journal", "model.mzn" }), BadArgument);
+}
+
+#if defined(__unix__)
+BOOST_AUTO_TEST_CASE(test_worker_command)
+{
+    const auto run = [](std::string_view worker_command)
+    {
+        const std::string command { worker_command };
+
+        std::vector<const char*> arguments { "test", "run", "--in-memory", "--compiler-path", "data/stub_compiler.sh", "--ignore-version-check", "--json", "--jobs", "2", "--data", "data/ror-1.dzn,data/ror-2.dzn" };
+
+        if (!command.empty())
+        {
+            arguments.push_back("--worker-command");
+            arguments.push_back(command.c_str());
+        }
+
+        arguments.push_back("data/ror.mzn");
+
+        return nlohmann::json::parse(get_output(arguments));
+    };
+
+    const auto local = run({});
+    const auto distributed = run(std::format("'{:s}' worker --compiler-path data/stub_compiler.sh", MUMINIZINC_EXECUTABLE_PATH));
+
+    BOOST_REQUIRE(!local.at("results").empty());
+    BOOST_CHECK(get_results(distributed) == get_results(local));
+    BOOST_CHECK(distributed.at("summary") == local.at("summary"));
+
+    // The first worker exits right away, so its job goes to the other one.
+    const auto lost_worker = run(std::format("[ {{worker}} = 0 ] && exit 1; exec '{:s}' worker --compiler-path data/stub_compiler.sh", MUMINIZINC_EXECUTABLE_PATH));
+
+    BOOST_CHECK(get_results(lost_worker) == get_results(local));
+    BOOST_CHECK(lost_worker.at("summary") == local.at("summary"));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_launcher)
+{
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "worker", "--launcher", " " }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "worker", "--launcher", "muminizinc-missing-launcher -c {cpu}" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "worker", "--launcher", "'muminizinc missing launcher' -c {cpu}" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "worker", "--launcher", "env \"A=b c" }), BadArgument);
+}
+
+BOOST_AUTO_TEST_CASE(test_limits)
+{
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--memory-limit", "a", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--memory-limit", "18446744073709551615", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--cpu-time-limit", "a", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--cpu-time-limit", "9223372036854775808", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--cpu-time-limit" }), BadArgument);
+}
+
+BOOST_AUTO_TEST_CASE(test_golden_outputs)
+{
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--golden-outputs", "outputs", "--schedule", "longest-first", "model.mzn" }), BadArgument);
+    BOOST_REQUIRE_THROW(parse_arguments(std::array { "test", "run", "--golden-outputs", "outputs", "--slowdown-factor", "2", "model.mzn" }), BadArgument);
+}
@@ -0,0 +1,214 @@
+#define BOOST_TEST_MODULE test_delta
+#include <boost/test/included/unit_test.hpp>
+
+#include <optional>    // std::optional
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+#include <muminizinc/delta.hpp> // MuMiniZinc::detail::split_items, MuMiniZinc::find_variable_declarations, MuMiniZinc::FlatItem, MuMiniZinc::FlatModel, MuMiniZinc::replace_flattened_item
+
+namespace
+{
+
+/** Two constraint items on the same line, so only the columns tell their constraints apart. */
+constexpr std::string_view original_model { R"(var 1..3: x;
+var 1..3: y;
+constraint x < y; constraint x != 2;
+solve satisfy;
+)" };
+
+/** The declarations of the original model along with its first constraint, mutated. */
+constexpr std::string_view mutated_model { R"(var 1..3: x;
+var 1..3: y;
+constraint x > y;
+solve satisfy;
+)" };
+
+constexpr std::string_view declarations_flatzinc { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+solve  satisfy;
+)fzn" };
+
+constexpr std::string_view original_flatzinc { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+constraint int_lt(x,y):: mzn_path("original.mzn|3|12|3|16|ce|il");
+constraint int_ne(x,2):: mzn_path("original.mzn|3|30|3|35|ce|il");
+solve  satisfy;
+)fzn" };
+
+constexpr std::string_view mutated_flatzinc { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+constraint int_lt(y,x):: mzn_path("mutant.mzn|3|12|3|16|ce|il");
+solve  satisfy;
+)fzn" };
+
+/** Replaces the first constraint of the original model with its mutated version. */
+std::optional<std::string> replace(std::string_view original, std::string_view mutated, std::string_view original_file = "original.mzn")
+{
+    const MuMiniZinc::FlatModel original_flat_model { std::string { original } };
+    const MuMiniZinc::FlatModel mutated_flat_model { std::string { mutated } };
+    const MuMiniZinc::FlatModel declarations { std::string { declarations_flatzinc } };
+
+    const auto original_items = MuMiniZinc::detail::split_items(original_model);
+    const auto mutated_items = MuMiniZinc::detail::split_items(mutated_model);
+    const auto variables = MuMiniZinc::find_variable_declarations(original_items);
+
+    const MuMiniZinc::FlattenedItem original_item { .flat_model = original_flat_model, .file = original_file, .model = original_model, .item = original_items[2] };
+    const MuMiniZinc::FlattenedItem mutated_item { .flat_model = mutated_flat_model, .file = "mutant.mzn", .model = mutated_model, .item = mutated_items[2] };
+
+    return MuMiniZinc::replace_flattened_item(original_item, mutated_item, declarations, variables);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(flat_model)
+{
+    const MuMiniZinc::FlatModel model { R"fzn(predicate my_predicate(var int: a);
+var 1..3: x:: output_var;
+var 2..6: X_INTRODUCED_0_ ::var_is_introduced :: is_defined_var;
+constraint int_lin_eq([1,-1],[x,X_INTRODUCED_0_],-1):: mzn_path("model.mzn|3|12|4|5|ce|il"):: defines_var(X_INTRODUCED_0_);
+constraint int_ne(x,2):: mzn_path("model.mzn|3");
+constraint int_ne(x,3);
+solve  satisfy;
+)fzn" };
+
+    const auto items = model.items();
+
+    BOOST_REQUIRE(items.size() == 7);
+
+    BOOST_CHECK(items[0].kind == MuMiniZinc::FlatItem::Kind::Other);
+
+    BOOST_CHECK(items[1].kind == MuMiniZinc::FlatItem::Kind::Declaration);
+    BOOST_CHECK(items[1].name == "x");
+    BOOST_CHECK(items[1].is_variable);
+    BOOST_CHECK(!items[1].is_introduced);
+
+    BOOST_CHECK(items[2].name == "X_INTRODUCED_0_");
+    BOOST_CHECK(items[2].is_introduced);
+
+    BOOST_CHECK(items[3].kind == MuMiniZinc::FlatItem::Kind::Constraint);
+    BOOST_CHECK(items[3].path_file == "model.mzn");
+    BOOST_CHECK(items[3].path_span.first_line == 3);
+    BOOST_CHECK(items[3].path_span.first_column == 12);
+    BOOST_CHECK(items[3].path_span.last_line == 4);
+    BOOST_CHECK(items[3].path_span.last_column == 5);
+    BOOST_CHECK(items[3].defined_variable == "X_INTRODUCED_0_");
+
+    // A path without its whole span is not taken into account.
+    BOOST_CHECK(items[4].path_span.first_line == 0);
+    BOOST_CHECK(items[5].path_span.first_line == 0);
+    BOOST_CHECK(items[5].defined_variable.empty());
+
+    BOOST_CHECK(items[6].kind == MuMiniZinc::FlatItem::Kind::Solve);
+
+    BOOST_CHECK(model.find_declaration("x") == &items[1]);
+    BOOST_CHECK(model.find_declaration("y") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(replacement)
+{
+    const auto merged = replace(original_flatzinc, mutated_flatzinc);
+
+    // The constraint of the other item on the same line is kept.
+    constexpr std::string_view expected { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+constraint int_lt(y,x):: mzn_path("mutant.mzn|3|12|3|16|ce|il");
+constraint int_ne(x,2):: mzn_path("original.mzn|3|30|3|35|ce|il");
+solve  satisfy;
+)fzn" };
+
+    BOOST_REQUIRE(merged.has_value());
+    BOOST_CHECK(*merged == expected);
+}
+
+BOOST_AUTO_TEST_CASE(replacement_without_paths)
+{
+    constexpr std::string_view original { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+constraint int_lt(x,y);
+solve  satisfy;
+)fzn" };
+
+    BOOST_CHECK(!replace(original, mutated_flatzinc).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(replacement_of_another_file)
+{
+    // No constraint can be attributed to the original item.
+    BOOST_CHECK(!replace(original_flatzinc, mutated_flatzinc, "/tmp/original.mzn").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(replacement_with_changed_domain)
+{
+    constexpr std::string_view mutated { R"fzn(var 1..2: x:: output_var;
+var 1..3: y:: output_var;
+constraint int_lt(y,x):: mzn_path("mutant.mzn|3|12|3|16|ce|il");
+solve  satisfy;
+)fzn" };
+
+    BOOST_CHECK(!replace(original_flatzinc, mutated).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(replacement_with_used_definition)
+{
+    // The variable defined by the original item is used by the constraint of the other one.
+    constexpr std::string_view original { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+var 2..6: X_INTRODUCED_0_ ::var_is_introduced :: is_defined_var;
+constraint int_lin_eq([1,1,-1],[x,y,X_INTRODUCED_0_],0):: mzn_path("original.mzn|3|12|3|16|ce|il"):: defines_var(X_INTRODUCED_0_);
+constraint int_ne(X_INTRODUCED_0_,4):: mzn_path("original.mzn|3|30|3|35|ce|il");
+solve  satisfy;
+)fzn" };
+
+    BOOST_CHECK(!replace(original, mutated_flatzinc).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(replacement_with_shared_definition)
+{
+    // The other item defines the variable first, and the original item only uses it, so the definition is kept.
+    constexpr std::string_view original { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+var 2..6: X_INTRODUCED_0_ ::var_is_introduced :: is_defined_var;
+constraint int_lin_eq([1,1,-1],[x,y,X_INTRODUCED_0_],0):: mzn_path("original.mzn|3|30|3|35|ce|il"):: defines_var(X_INTRODUCED_0_);
+constraint int_le(X_INTRODUCED_0_,4):: mzn_path("original.mzn|3|12|3|16|ce|il");
+constraint int_ne(X_INTRODUCED_0_,4):: mzn_path("original.mzn|3|30|3|35|ce|il");
+solve  satisfy;
+)fzn" };
+
+    const auto merged = replace(original, mutated_flatzinc);
+
+    constexpr std::string_view expected { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+var 2..6: X_INTRODUCED_0_ ::var_is_introduced :: is_defined_var;
+constraint int_lin_eq([1,1,-1],[x,y,X_INTRODUCED_0_],0):: mzn_path("original.mzn|3|30|3|35|ce|il"):: defines_var(X_INTRODUCED_0_);
+constraint int_lt(y,x):: mzn_path("mutant.mzn|3|12|3|16|ce|il");
+constraint int_ne(X_INTRODUCED_0_,4):: mzn_path("original.mzn|3|30|3|35|ce|il");
+solve  satisfy;
+)fzn" };
+
+    BOOST_REQUIRE(merged.has_value());
+    BOOST_CHECK(*merged == expected);
+}
+
+BOOST_AUTO_TEST_CASE(replacement_with_changed_declarations)
+{
+    // The mutated item shares its subexpression with the declarations, which then define a variable through it.
+    constexpr std::string_view shared { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var;
+var 2..6: X_INTRODUCED_0_ ::var_is_introduced :: is_defined_var;
+constraint int_lin_eq([1,1,-1],[x,y,X_INTRODUCED_0_],0):: mzn_path("mutant.mzn|3|12|3|16|ce|il"):: defines_var(X_INTRODUCED_0_);
+constraint int_le(X_INTRODUCED_0_,4):: mzn_path("mutant.mzn|1|1|1|12|ce|il");
+solve  satisfy;
+)fzn" };
+
+    BOOST_CHECK(!replace(original_flatzinc, shared).has_value());
+
+    // Flattening the mutated item has changed the declaration of a variable of the model.
+    constexpr std::string_view defined { R"fzn(var 1..3: x:: output_var;
+var 1..3: y:: output_var:: is_defined_var;
+constraint int_lin_eq([1,-1],[x,y],0):: mzn_path("mutant.mzn|3|12|3|16|ce|il"):: defines_var(y);
+solve  satisfy;
+)fzn" };
+
+    BOOST_CHECK(!replace(original_flatzinc, defined).has_value());
+}
@@ -0,0 +1,311 @@
+#define BOOST_TEST_MODULE test_executor
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>   // std::ranges::count
+#include <array>       // std::array
+#include <chrono>      // std::chrono::seconds
+#include <cstdint>     // std::uint64_t
+#include <filesystem>  // std::filesystem::exists, std::filesystem::path, std::filesystem::remove, std::filesystem::temp_directory_path
+#include <format>      // std::format
+#include <fstream>     // std::ifstream
+#include <random>      // std::random_device
+#include <span>        // std::span
+#include <string>      // std::getline, std::string
+#include <string_view> // std::string_view
+#include <vector>      // std::vector
+
+#include <muminizinc/executor.hpp> // MuMiniZinc::execute_mutants, MuMiniZinc::execution_args, MuMiniZinc::ExecutionError
+#include <muminizinc/mutation.hpp> // MuMiniZinc::Entry, MuMiniZinc::ExecutionEngine
+
+#if defined(__unix__)
+#    include <stdlib.h> // setenv, unsetenv
+#endif
+
+namespace
+{
+
+using Status = MuMiniZinc::Entry::Status;
+
+const std::filesystem::path data_path { "data" };
+
+/** Behaves as the first word of every model asks, so every mutant tells the stub how its execution ends. */
+const std::filesystem::path compiler_path { data_path / "stub_solver.sh" };
+
+#if defined(__unix__)
+/** A path in the temporary directory that no other run of the tests uses. */
+std::filesystem::path get_temporary_path(std::string_view name)
+{
+    return std::filesystem::temp_directory_path() / std::format("muminizinc-test-{:08x}-{:s}", std::random_device {}(), name);
+}
+
+/** Returns a mutant for every model, named after it. */
+std::vector<MuMiniZinc::Entry> get_entries(std::span<const std::string_view> models)
+{
+    std::vector<MuMiniZinc::Entry> entries;
+
+    for (const auto model : models)
+        entries.emplace_back(std::string { model }, std::string { model });
+
+    return entries;
+}
+
+/** Returns the parameters for running the mutants with the stub compiler, without data files nor limits. */
+MuMiniZinc::execution_args get_parameters(std::span<MuMiniZinc::Entry> entries)
+{
+    return MuMiniZinc::execution_args {
+        .compiler_path = compiler_path,
+        .compiler_arguments = {},
+        .data_files = {},
+        .entries = entries,
+        .original_usages = {},
+        .normalized_model = "original",
+        .timeout = {},
+        .n_jobs = 2,
+        .allowed_mutants = {},
+        .check_compiler_version = false,
+        .output_log = {},
+        .engine = MuMiniZinc::ExecutionEngine::Process,
+        .reuse_original_solutions = false,
+        .max_output_size = 0,
+        .max_error_size = 0
+    };
+}
+
+/** Returns the status of every mutant with its only data file. */
+std::vector<Status> get_statuses(std::span<const MuMiniZinc::Entry> entries)
+{
+    std::vector<Status> statuses;
+
+    for (const auto& entry : entries)
+        statuses.push_back(entry.results.at(0));
+
+    return statuses;
+}
+
+/** Logs the executions of the stub compiler to a temporary file while it exists. */
+class ExecutionLog
+{
+public:
+    ExecutionLog() :
+        m_path { get_temporary_path("executions.log") }
+    {
+        setenv("STUB_SOLVER_LOG", m_path.c_str(), 1);
+    }
+
+    ExecutionLog(const ExecutionLog&) = delete;
+    ExecutionLog& operator=(const ExecutionLog&) = delete;
+
+    ~ExecutionLog()
+    {
+        unsetenv("STUB_SOLVER_LOG");
+        std::filesystem::remove(m_path);
+    }
+
+    /** Returns the models the stub compiler has run, in the order they started. */
+    [[nodiscard]] std::vector<std::string> get_models() const
+    {
+        std::ifstream file { m_path };
+        std::vector<std::string> models;
+
+        for (std::string line; std::getline(file, line);)
+            models.push_back(line);
+
+        return models;
+    }
+
+private:
+    std::filesystem::path m_path;
+};
+#endif
+
+} // namespace
+
+#if defined(__unix__)
+BOOST_AUTO_TEST_CASE(test_early_stop)
+{
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "other" }, std::string_view { "diverge" }, std::string_view { "unknown" }, std::string_view { "timeout" }, std::string_view { "error" } };
+
+    auto entries = get_entries(models);
+    MuMiniZinc::execute_mutants(get_parameters(entries));
+
+    BOOST_CHECK(get_statuses(entries) == (std::vector { Status::Alive, Status::Dead, Status::Dead, Status::Dead, Status::Timeout, Status::Invalid }));
+
+    // The mutant that diverges at its first line is stopped there, instead of running until the solver exits.
+    BOOST_CHECK(entries[2].usages.at(0).wall_time < std::chrono::seconds { 30 });
+}
+
+BOOST_AUTO_TEST_CASE(test_io_threads)
+{
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "other" }, std::string_view { "diverge" }, std::string_view { "error" }, std::string_view { "same" }, std::string_view { "timeout" }, std::string_view { "other" }, std::string_view { "error" } };
+
+    auto entries = get_entries(models);
+
+    // Every execution is handled on its own strand, while the results are recorded on the strand of the scheduler.
+    auto parameters = get_parameters(entries);
+    parameters.n_jobs = 4;
+    parameters.io_threads = 4;
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_CHECK(get_statuses(entries) == (std::vector { Status::Alive, Status::Dead, Status::Dead, Status::Invalid, Status::Alive, Status::Timeout, Status::Dead, Status::Invalid }));
+}
+
+BOOST_AUTO_TEST_CASE(test_model_error)
+{
+    constexpr std::array models { std::string_view { "typeerror" }, std::string_view { "late-typeerror" } };
+    const std::array data_files { (data_path / "aor-1.dzn").string(), (data_path / "aor-2.dzn").string() };
+
+    const ExecutionLog log;
+    auto entries = get_entries(models);
+
+    // A single job, so the executions run in order.
+    auto parameters = get_parameters(entries);
+    parameters.data_files = data_files;
+    parameters.n_jobs = 1;
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    // A type error in the model fails with any data file, so the mutant is not run with the second one.
+    BOOST_CHECK(entries[0].results == (std::vector { Status::Invalid, Status::Invalid }));
+    BOOST_CHECK(std::ranges::count(log.get_models(), "typeerror") == 1);
+
+    // The result that has already been recorded is kept.
+    BOOST_CHECK(entries[1].results == (std::vector { Status::Alive, Status::Invalid }));
+}
+
+BOOST_AUTO_TEST_CASE(test_time_limit)
+{
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "hang" } };
+
+    auto entries = get_entries(models);
+
+    auto parameters = get_parameters(entries);
+    parameters.timeout = std::chrono::seconds { 1 };
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    // The stub ignores the time limit given to it, so the executor stops it past the margin.
+    BOOST_CHECK(get_statuses(entries) == (std::vector { Status::Alive, Status::Timeout }));
+    BOOST_CHECK(entries[1].usages.at(0).wall_time < std::chrono::seconds { 30 });
+}
+
+BOOST_AUTO_TEST_CASE(test_resource_limits)
+{
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "oom" }, std::string_view { "spin" } };
+
+    auto entries = get_entries(models);
+
+    auto parameters = get_parameters(entries);
+    parameters.memory_limit = std::uint64_t { 4 } * 1024 * 1024 * 1024;
+    parameters.cpu_time_limit = std::chrono::seconds { 1 };
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_CHECK(entries[0].results.at(0) == Status::Alive);
+    BOOST_CHECK(entries[1].results.at(0) == Status::LimitExceeded);
+
+#    if defined(__linux__)
+    // Only the executions reaped on Linux are known to have been killed by their CPU time limit.
+    BOOST_CHECK(entries[2].results.at(0) == Status::LimitExceeded);
+#    endif
+}
+
+BOOST_AUTO_TEST_CASE(test_output_limit)
+{
+    constexpr std::array models { std::string_view { "same" } };
+
+    auto entries = get_entries(models);
+
+    // The output of the original model is captured, so it is the one that exceeds the limit.
+    auto parameters = get_parameters(entries);
+    parameters.max_output_size = 4;
+
+    BOOST_CHECK_THROW(MuMiniZinc::execute_mutants(parameters), MuMiniZinc::ExecutionError);
+}
+
+BOOST_AUTO_TEST_CASE(test_cache)
+{
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "other" }, std::string_view { "error" } };
+
+    const ExecutionLog log;
+    const auto cache_path = get_temporary_path("cache");
+
+    auto entries = get_entries(models);
+
+    auto parameters = get_parameters(entries);
+    parameters.cache_path = cache_path;
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_REQUIRE(std::filesystem::exists(cache_path));
+    BOOST_CHECK(log.get_models().size() == models.size() + 1);
+
+    // Every execution is cached, so nothing runs again and the results are the same.
+    auto cached_entries = get_entries(models);
+
+    parameters.entries = cached_entries;
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_CHECK(log.get_models().size() == models.size() + 1);
+    BOOST_CHECK(get_statuses(cached_entries) == get_statuses(entries));
+    BOOST_CHECK(get_statuses(cached_entries) == (std::vector { Status::Alive, Status::Dead, Status::Invalid }));
+
+    // A limit may change the status of an execution, so the results cached without it are not used.
+    auto limited_entries = get_entries(models);
+
+    parameters.entries = limited_entries;
+    parameters.cpu_time_limit = std::chrono::seconds { 60 };
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_CHECK(log.get_models().size() == 2 * (models.size() + 1));
+    BOOST_CHECK(get_statuses(limited_entries) == get_statuses(entries));
+
+    std::filesystem::remove(cache_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_resume)
+{
+    constexpr std::array first_models { std::string_view { "same" }, std::string_view { "other" } };
+    constexpr std::array models { std::string_view { "same" }, std::string_view { "other" }, std::string_view { "error" } };
+
+    const ExecutionLog log;
+    const auto journal_path = get_temporary_path("journal");
+
+    // The first run stops before the last mutant, as if it had been interrupted.
+    auto first_entries = get_entries(first_models);
+
+    auto first_parameters = get_parameters(first_entries);
+    first_parameters.journal_path = journal_path;
+
+    MuMiniZinc::execute_mutants(first_parameters);
+
+    BOOST_REQUIRE(std::filesystem::exists(journal_path));
+
+    auto entries = get_entries(models);
+
+    auto parameters = get_parameters(entries);
+    parameters.journal_path = journal_path;
+    parameters.resume = true;
+
+    MuMiniZinc::execute_mutants(parameters);
+
+    // Only the original model, which is not journaled, and the mutant that had not run are run again.
+    const auto executions = log.get_models();
+
+    BOOST_CHECK(executions.size() == first_models.size() + 3);
+    BOOST_CHECK(executions.back() == "error");
+    BOOST_CHECK(get_statuses(entries) == (std::vector { Status::Alive, Status::Dead, Status::Invalid }));
+
+    // The journal is appended to, so resuming again runs none of the mutants.
+    auto resumed_entries = get_entries(models);
+
+    parameters.entries = resumed_entries;
+    MuMiniZinc::execute_mutants(parameters);
+
+    BOOST_CHECK(log.get_models().size() == first_models.size() + 4);
+    BOOST_CHECK(log.get_models().back() == "original");
+    BOOST_CHECK(get_statuses(resumed_entries) == get_statuses(entries));
+
+    std::filesystem::remove(journal_path);
+}
+#endif
@@ -1,14 +1,17 @@
 #define BOOST_TEST_MODULE test_mutation
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>  // std::ranges::sort
 #include <array>      // std::array
 #include <chrono>     // std::chrono::hours
-#include <filesystem> // std::filesystem::absolute, std::filesystem::exists, std::filesystem::last_write_time, std::filesystem::path
+#include <filesystem> // std::filesystem::absolute, std::filesystem::exists, std::filesystem::last_write_time, std::filesystem::path, std::filesystem::remove_all
 #include <fstream>    // std::ofstream
 #include <stdexcept>  // std::runtime_error
+#include <vector>     // std::vector
 
+#include <muminizinc/delta.hpp>    // MuMiniZinc::detail::find_mutated_item, MuMiniZinc::detail::MutatedItem, MuMiniZinc::detail::split_items
 #include <muminizinc/executor.hpp> // MuMiniZinc::UnknownMutant
-#include <muminizinc/mutation.hpp> // MuMiniZinc::clear_mutant_output_folder, MuMiniZinc::find_mutants, MuMiniZinc::find_mutants_args, MuMiniZinc::get_path_from_model_path, MuMiniZinc::retrieve_mutants, MuMiniZinc::retrieve_mutants_args, MuMiniZinc::run_mutants, MuMiniZinc::run_mutants_args
+#include <muminizinc/mutation.hpp> // MuMiniZinc::clear_mutant_output_folder, MuMiniZinc::dump_mutants, MuMiniZinc::Entry, MuMiniZinc::find_mutants, MuMiniZinc::find_mutants_args, MuMiniZinc::get_path_from_model_path, MuMiniZinc::retrieve_mutants, MuMiniZinc::retrieve_mutants_args, MuMiniZinc::run_mutants, MuMiniZinc::run_mutants_args
 
 namespace
 {
@@ -328,4 +331,64 @@ output  ["\"set of int: Test"]++["\n\"enum Test"];
 )" };
 
     BOOST_CHECK(entries.normalized_model() == expected_normalized_model);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(mutated_item)
+{
+    const std::filesystem::path model_path { data_path / "aor.mzn" };
+
+    const MuMiniZinc::find_mutants_args find_parameters {
+        .model = model_path,
+        .allowed_operators = {},
+        .include_path = {}
+    };
+
+    const auto entries = MuMiniZinc::find_mutants(find_parameters);
+
+    BOOST_REQUIRE(!entries.mutants().empty());
+
+    for (const auto& mutant : entries.mutants())
+    {
+        BOOST_REQUIRE(mutant.mutated_item.has_value());
+
+        const auto item = MuMiniZinc::detail::find_mutated_item(entries.normalized_model(), mutant.contents, *mutant.mutated_item);
+
+        BOOST_REQUIRE(item.has_value());
+        BOOST_CHECK(item->kind == MuMiniZinc::detail::MutatedItem::Kind::Constraint);
+        BOOST_CHECK(item->index == 1);
+    }
+
+    // The position of the mutated item is kept when the mutants are dumped and retrieved.
+    const auto mutant_folder_path { data_path / "mutated-item-test" };
+
+    BOOST_REQUIRE(!std::filesystem::exists(mutant_folder_path));
+
+    MuMiniZinc::dump_mutants(entries, mutant_folder_path);
+
+    const MuMiniZinc::retrieve_mutants_args retrieve_parameters {
+        .model_path = model_path,
+        .directory_path = mutant_folder_path,
+        .allowed_operators = {},
+        .allowed_mutants = {},
+        .check_model_last_modified_time = false
+    };
+
+    const auto retrieved_entries = MuMiniZinc::retrieve_mutants(retrieve_parameters);
+
+    std::vector<MuMiniZinc::Entry> mutants { entries.mutants().begin(), entries.mutants().end() };
+    std::vector<MuMiniZinc::Entry> retrieved_mutants { retrieved_entries.mutants().begin(), retrieved_entries.mutants().end() };
+
+    std::ranges::sort(mutants);
+    std::ranges::sort(retrieved_mutants);
+
+    BOOST_CHECK(retrieved_mutants == mutants);
+    BOOST_CHECK(retrieved_entries.normalized_model() == entries.normalized_model());
+
+    BOOST_REQUIRE(std::filesystem::remove_all(mutant_folder_path));
+
+    // Semicolons inside strings and let expressions do not split items.
+    constexpr std::string_view model { "int: a = let { int: b = 1; } in b;\noutput [\";\"];\n" };
+
+    BOOST_CHECK(MuMiniZinc::detail::split_items(model).size() == 2);
+    BOOST_CHECK(!MuMiniZinc::detail::find_mutated_item(model, model, 0).has_value());
+}